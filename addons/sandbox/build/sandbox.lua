@@ -20,7 +20,6 @@ dependson{
 
 defines{
 	"_CRT_SECURE_NO_WARNINGS", "NOMINMAX",
-	"IMGUI_API=__declspec(dllimport)",
 }
 
 undefines{
@@ -43,7 +42,6 @@ libdirs{
 }
 
 links{
-	"opengl32",
 	"glfw",
 	"imgui",
 	"modus_core",
@@ -69,34 +67,55 @@ files{
 	"%{wks.location}/addons/%{prj.name}/source/**.**",
 }
 
-postbuildcommands{
-	"%{ml_copy} %{wks.location}\\bin-lib\\%{cfg.platform}\\%{cfg.buildcfg}\\addons\\%{prj.name}%{ml_dll} %{wks.location}\\bin\\%{cfg.platform}\\%{cfg.buildcfg}\\addons\\",
-}
-
 filter{ "configurations:Debug" }
 	symbols "On"
-	links{
-		"glew32d",
-		"python39_d",
-	}
 
 filter{ "configurations:Release" }
 	optimize "Speed"
-	links{
-		"glew32",
-		"python39",
-	}
 
 -- WINDOWS
 
+filter{ "system:Windows" }
+	defines{
+		"IMGUI_API=__declspec(dllimport)",
+	}
+	links{
+		"opengl32",
+	}
+	postbuildcommands{
+		"%{ml_copy} %{wks.location}\\bin-lib\\%{cfg.platform}\\%{cfg.buildcfg}\\addons\\%{prj.name}%{ml_dll} %{wks.location}\\bin\\%{cfg.platform}\\%{cfg.buildcfg}\\addons\\",
+	}
+
 filter{ "system:Windows", "configurations:Debug" }
+	links{
+		"glew32d",
+		"python39_d",
+	}
 	linkoptions{
 		"/NODEFAULTLIB:MSVCRT.lib", "/NODEFAULTLIB:LIBCMT.lib", "/NODEFAULTLIB:LIBCMTD.lib"
 	}
 
 filter{ "system:Windows", "configurations:Release" }
+	links{
+		"glew32",
+		"python39",
+	}
 	linkoptions{
 		"/NODEFAULTLIB:LIBCMT.lib"
 	}
 
+-- LINUX
+
+filter{ "system:linux" }
+	pic "On"
+	links{
+		"GLEW",
+		"OpenGL",
+		"python3.9",
+	}
+	postbuildcommands{
+		"mkdir -p %{wks.location}/bin/%{cfg.platform}/%{cfg.buildcfg}/addons/",
+		"%{ml_copy} %{wks.location}/bin-lib/%{cfg.platform}/%{cfg.buildcfg}/addons/lib%{prj.name}%{ml_dll} %{wks.location}/bin/%{cfg.platform}/%{cfg.buildcfg}/addons/",
+	}
+
 -- * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * --
\ No newline at end of file
@@ -4,6 +4,7 @@
 layout(location = 0) in vec3 a_position;
 layout(location = 1) in vec3 a_normal;
 layout(location = 2) in vec2 a_texcoord;
+layout(location = 3) in mat4 a_model;
 
 out vertex {
     vec3 position;
@@ -11,16 +12,17 @@ out vertex {
     vec2 texcoord;
 } V;
 
-uniform mat4 u_model;
-uniform mat4 u_view;
-uniform mat4 u_proj;
+layout(std140, binding = 0) uniform frame_block {
+    mat4 u_view;
+    mat4 u_proj;
+};
 
 void main()
 {
     V.position  = a_position;
     V.normal    = a_normal;
     V.texcoord  = a_texcoord;
-    gl_Position = (u_proj * u_view * u_model) * vec4(V.position, 1.0);
+    gl_Position = (u_proj * u_view * a_model) * vec4(V.position, 1.0);
 }
 
 #pragma shader pixel
@@ -34,7 +36,10 @@ in vertex {
     vec2 texcoord;
 } V;
 
-uniform vec4 u_color;
+layout(std140, binding = 1) uniform material_block {
+    vec4 u_color;
+};
+
 uniform sampler2D u_texture;
 
 void main()
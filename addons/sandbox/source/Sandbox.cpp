@@ -27,6 +27,7 @@ namespace ml
 		bool // main panels
 				m_show_viewport				{ true },
 				m_show_terminal				{ false },
+				m_show_gpu_profiler			{ false },
 				m_show_scene_editor			{ true };
 		
 		// debug overlay
@@ -37,6 +38,7 @@ namespace ml
 		
 		stream_sniper m_cout{ &std::cout }; // 
 		ImGuiExt::Terminal m_terminal{}; // 
+		ImGuiExt::GpuProfilerPanel m_gpu_panel{}; // 
 		ImGuiExt::TransformEditor m_xeditor{}; // 
 
 		bool	m_grid_enabled{ true }; // 
@@ -53,6 +55,9 @@ namespace ml
 		hash_map<string, ref<gfx::program>> m_programs{}; // programs
 		hash_map<string, ref<gfx::shader>> m_shaders{}; // shaders
 		hash_map<string, ref<mesh>> m_meshes{}; // meshes
+		hash_map<string, ref<material>> m_materials{}; // materials
+		scope<uniform_ring> m_uniforms{}; // per frame uniform blocks
+		scope<instance_batcher> m_batcher{}; // instanced draws
 
 		// rendering
 		bool m_shift_bg_hue{ true }; // cycle background
@@ -102,6 +107,7 @@ namespace ml
 				runtime_startup_event,
 				runtime_shutdown_event,
 				runtime_idle_event,
+				runtime_fixed_update_event,
 				dockspace_builder_event,
 				runtime_gui_event,
 				runtime_end_frame_event,
@@ -121,6 +127,7 @@ namespace ml
 			case runtime_startup_event	::ID: return on_runtime_startup((runtime_startup_event const &)value);
 			case runtime_shutdown_event	::ID: return on_runtime_shutdown((runtime_shutdown_event const &)value);
 			case runtime_idle_event		::ID: return on_runtime_update((runtime_idle_event const &)value);
+			case runtime_fixed_update_event::ID: return on_runtime_fixed_update((runtime_fixed_update_event const &)value);
 			case dockspace_builder_event::ID: return on_dockspace_builder((dockspace_builder_event const &)value);
 			case runtime_gui_event		::ID: return on_runtime_gui((runtime_gui_event const &)value);
 			case runtime_end_frame_event::ID: return on_runtime_frame_end((runtime_end_frame_event const &)value);
@@ -162,8 +169,19 @@ namespace ml
 			}
 			
 			// programs
-			m_programs["2D"] = gfx::parse_program(path2("addons/sandbox/resource/shaders/basic_2D.shader"));
-			m_programs["3D"] = gfx::parse_program(path2("addons/sandbox/resource/shaders/basic_3D.shader"));
+			m_programs["2D"] = gfx::parse_program_async(path2("addons/sandbox/resource/shaders/basic_2D.shader"));
+			m_programs["3D"] = gfx::parse_program_async(path2("addons/sandbox/resource/shaders/basic_3D.shader"));
+
+			// uniforms
+			m_uniforms = make_scope<uniform_ring>(64 * 1024);
+
+			// materials
+			m_materials["earth"] = make_ref<material>(m_programs["3D"]);
+			m_materials["earth"]->set("u_color", (vec4)colors::white);
+			m_materials["earth"]->set_texture(0, m_textures["earth_dm_2k"]);
+
+			// batching
+			m_batcher = make_scope<instance_batcher>();
 
 			// meshes
 			m_meshes["sphere8x6"] = make_ref<mesh>(path2("assets/models/sphere8x6.obj"));
@@ -226,13 +244,25 @@ namespace ml
 
 			duration const dt{ ev->get_delta_time() };
 
+			for (auto const & [name, tree] : m_scenes)
+			{
+				tree->on_runtime_update(dt);
+
+				if (tree->consume_invalidated()) { ev->invalidate(); }
+			}
+
 			input_state * const input{ ev->get_input() };
 
 			vec2 const view_size{ m_viewport.get_rect().size() };
 
-			for (auto const & fb : m_framebuffers) { fb->resize(view_size); }
+			for (auto const & fb : m_framebuffers) {
+				ev->submit([fb, view_size](gfx::render_context *) { fb->resize(view_size); });
+			}
 
-			if (m_shift_bg_hue) { m_camera.set_background(util::rotate_hue(m_camera.get_background(), dt * 10)); }
+			if (m_shift_bg_hue) {
+				m_camera.set_background(util::rotate_hue(m_camera.get_background(), dt * 10));
+				ev->invalidate();
+			}
 
 			if (m_dragging_view) {
 				vec2 const md{ input->mouse_delta * (dt * 50) };
@@ -248,30 +278,46 @@ namespace ml
 			m_cc.set_position(pos);
 			m_cc.recalculate(view_size);
 
-			static auto const & pgm{ m_programs["3D"] };
-			static auto const & tex{ m_textures["earth_dm_2k"] };
 			static auto const & msh{ m_meshes["sphere32x24"] };
+			static auto const & mtl{ m_materials["earth"] };
 			static auto const & vs{ m_shaders["vs"] }, & ps{ m_shaders["ps"] };
-			ev->get_render_context()->execute
+			gfx::command_buffer & cmds{ ev->get_commands() };
+			cmds.bind_framebuffer(m_framebuffers[0]);
+			cmds.set_clear_color(m_camera.get_background());
+			cmds.clear(m_camera.get_clear_flags());
+			ev->submit
 			(
-				gfx::command::bind_framebuffer(m_framebuffers[0]),
-				gfx::command::set_clear_color(m_camera.get_background()),
-				gfx::command::clear(m_camera.get_clear_flags()),
-				[&](gfx::render_context * ctx)
+				[
+					&ring = *m_uniforms,
+					&batcher = *m_batcher,
+					profiler = ev->get_gpu_profiler(),
+					count = m_object_count,
+					models = array<mat4, 4>{ m_object_matrix[0], m_object_matrix[1], m_object_matrix[2], m_object_matrix[3] },
+					frame = array<mat4, 2>{ m_camera.get_view_matrix(), m_camera.get_proj_matrix() }
+				](gfx::render_context * ctx)
 				{
-					if (0 == m_object_count) { return; }
-					pgm->bind();
-					pgm->set_uniform("u_model", m_object_matrix[0]);
-					pgm->set_uniform("u_view", m_camera.get_view_matrix());
-					pgm->set_uniform("u_proj", m_camera.get_proj_matrix());
-					pgm->set_uniform("u_color", (vec4)colors::white);
-					pgm->set_uniform("u_texture", tex);
-					pgm->bind_textures();
-					ctx->draw(msh->get_vertexarray());
-					pgm->unbind();
-				},
-				gfx::command::bind_framebuffer(0)
+					ML_gpu_scope(profiler, ctx, "scene");
+
+					// camera block, written once and shared by every draw this frame
+					ring.next_frame();
+					ring.bind(gfx::uniform_binding_frame, ring.push(sizeof(frame), frame.data()), sizeof(frame));
+
+					// objects sharing a mesh and material become one instanced draw
+					batcher.clear();
+					for (int32 i = 0; i < count; ++i)
+					{
+						batcher.push(msh.get(), mtl.get(), models[i]);
+					}
+					batcher.execute(ctx, ring);
+					ctx->bind_program(nullptr);
+				}
 			);
+			cmds.bind_framebuffer(nullptr);
+		}
+
+		void on_runtime_fixed_update(runtime_fixed_update_event const & ev)
+		{
+			for (auto const & [name, tree] : m_scenes) { tree->on_runtime_fixed_update(ev.dt); }
 		}
 		
 		void on_dockspace_builder(dockspace_builder_event const & ev)
@@ -337,6 +383,7 @@ namespace ml
 				if (ImGui::BeginMenu("view")) {
 					if (ImGui::MenuItem("overlay", "", &m_show_overlay)) {}
 					if (ImGui::MenuItem("terminal", "", &m_show_terminal)) {}
+					if (ImGui::MenuItem("gpu profiler", "", &m_show_gpu_profiler)) {}
 					if (ImGui::MenuItem("viewport", "", &m_show_viewport)) {}
 					ImGui::EndMenu();
 				}
@@ -445,6 +492,13 @@ namespace ml
 				m_terminal.Draw("terminal", &m_show_terminal, ImGuiWindowFlags_MenuBar);
 			}
 
+			// GPU PROFILER
+			if (m_show_gpu_profiler)
+			{
+				ImGui::SetNextWindowSize(winsize / 3, ImGuiCond_Once);
+				m_gpu_panel.Draw("gpu profiler", app->get_gpu_profiler(), &m_show_gpu_profiler);
+			}
+
 			// OVERLAY
 			if (m_show_overlay)
 			{
@@ -483,7 +537,19 @@ namespace ml
 				{
 					ImGui::TextDisabled("debug");
 					ImGui::Text("%.3f ms/frame ( %.1f fps )", 1000.f / fps, fps);
+					ImGui::Text("gpu: %.3f ms, cpu wait: %.3f ms",
+						app->get_frame_sync()->get_gpu_time().count() * 1000.f,
+						app->get_frame_sync()->get_cpu_wait().count() * 1000.f);
 					ImGui::Text("time: %.2f", time);
+					ImGui::NewLine();
+
+					gfx::render_stats const stats{ app->get_render_device()->get_stats() };
+					ImGui::TextDisabled("render");
+					ImGui::Text("draws: %llu, primitives: %llu", stats.draw_calls, stats.primitives);
+					ImGui::Text("binds: program %llu, texture %llu, vao %llu, fbo %llu",
+						stats.program_binds, stats.texture_binds, stats.vertexarray_binds, stats.framebuffer_binds);
+					ImGui::Text("uploads: %llu uniforms, %llu bytes", stats.uniform_uploads, stats.bytes_uploaded);
+					ImGui::Text("objects: +%llu -%llu", stats.objects_created, stats.objects_destroyed);
 					ImGui::Text("view rect: (%.1f,%.1f,%.1f,%.1f)", view_rect[0], view_rect[1], view_rect[2], view_rect[3]);
 					if (ImGui::IsItemHovered()) {
 						ImGui::GetForegroundDrawList()->AddRect(view_rect.min(), view_rect.max(), IM_COL32(255, 155, 0, 255));
@@ -4,8 +4,10 @@
 #include <modus_core/detail/FileUtility.hpp>
 #include <modus_core/detail/StreamSniper.hpp>
 #include <modus_core/embed/Python.hpp>
+#include <modus_core/graphics/InstanceBatcher.hpp>
 #include <modus_core/graphics/Material.hpp>
 #include <modus_core/graphics/Mesh.hpp>
+#include <modus_core/gui/GpuProfilerPanel.hpp>
 #include <modus_core/gui/Terminal.hpp>
 #include <modus_core/runtime/Application.hpp>
 #include <modus_core/scene/Components.hpp>
@@ -27,7 +27,6 @@ defines{
 	"ML_IMPL_RENDERER_OPENGL",
 	"ML_IMPL_OPENGL_LOADER_GLEW",
 	--"ML_IMPL_OPENGL_LOADER_GLAD",
-	"IMGUI_API=__declspec(dllimport)",
 }
 
 undefines{
@@ -50,7 +49,6 @@ libdirs{
 }
 
 links{
-	"opengl32",
 	"glfw",
 	"imgui",
 	"freetype",
@@ -83,16 +81,32 @@ files{
 	"%{wks.location}/source/%{prj.name}/**.**",
 }
 
-prebuildcommands{
-	"%{ml_copy} %{wks.location}\\vendor\\bin\\%{cfg.platform}\\%{cfg.buildcfg}\\assimp%{ml_dll} %{wks.location}\\bin\\%{cfg.platform}\\%{cfg.buildcfg}\\",
-}
-
-postbuildcommands{
-	"%{ml_copy} %{wks.location}\\bin-lib\\%{cfg.platform}\\%{cfg.buildcfg}\\%{prj.name}%{ml_dll} %{wks.location}\\bin\\%{cfg.platform}\\%{cfg.buildcfg}\\",
-}
-
 filter{ "configurations:Debug" }
 	symbols "On"
+
+filter{ "configurations:Release" }
+	optimize "Speed"
+
+-- WINDOWS
+
+filter{ "system:Windows" }
+	defines{
+		"IMGUI_API=__declspec(dllimport)",
+	}
+	links{
+		"opengl32",
+	}
+	buildoptions{
+		"/bigobj"
+	}
+	prebuildcommands{
+		"%{ml_copy} %{wks.location}\\vendor\\bin\\%{cfg.platform}\\%{cfg.buildcfg}\\assimp%{ml_dll} %{wks.location}\\bin\\%{cfg.platform}\\%{cfg.buildcfg}\\",
+	}
+	postbuildcommands{
+		"%{ml_copy} %{wks.location}\\bin-lib\\%{cfg.platform}\\%{cfg.buildcfg}\\%{prj.name}%{ml_dll} %{wks.location}\\bin\\%{cfg.platform}\\%{cfg.buildcfg}\\",
+	}
+
+filter{ "system:Windows", "configurations:Debug" }
 	links{
 		"glew32d",
 		"python39_d",
@@ -100,9 +114,11 @@ filter{ "configurations:Debug" }
 	prebuildcommands{
 		"%{ml_copy} %{wks.location}\\vendor\\bin\\%{cfg.platform}\\%{cfg.buildcfg}\\python39_d%{ml_dll} %{wks.location}\\bin\\%{cfg.platform}\\%{cfg.buildcfg}\\",
 	}
+	linkoptions{
+		"/NODEFAULTLIB:MSVCRT.lib", "/NODEFAULTLIB:LIBCMT.lib", "/NODEFAULTLIB:LIBCMTD.lib"
+	}
 
-filter{ "configurations:Release" }
-	optimize "Speed"
+filter{ "system:Windows", "configurations:Release" }
 	links{
 		"glew32",
 		"python39",
@@ -110,22 +126,40 @@ filter{ "configurations:Release" }
 	prebuildcommands{
 		"%{ml_copy} %{wks.location}\\vendor\\bin\\%{cfg.platform}\\%{cfg.buildcfg}\\python39%{ml_dll} %{wks.location}\\bin\\%{cfg.platform}\\%{cfg.buildcfg}\\",
 	}
+	linkoptions{
+		"/NODEFAULTLIB:LIBCMT.lib"
+	}
 
--- WINDOWS
+-- LINUX
 
-filter{ "system:Windows" }
-	buildoptions{
-		"/bigobj"
+-- libOpenGL and libEGL come from glvnd, neither needs an x11 display
+filter{ "system:linux" }
+	pic "On"
+	defines{
+		"ML_IMPL_HEADLESS_EGL",
 	}
-
-filter{ "system:Windows", "configurations:Debug" }
-	linkoptions{
-		"/NODEFAULTLIB:MSVCRT.lib", "/NODEFAULTLIB:LIBCMT.lib", "/NODEFAULTLIB:LIBCMTD.lib"
+	removefiles{
+		"%{wks.location}/source/%{prj.name}/backends/win32/**.**",
+	}
+	links{
+		"GLEW",
+		"OpenGL",
+		"EGL",
+		"python3.9",
+		"dl",
+		"pthread",
+	}
+	postbuildcommands{
+		"mkdir -p %{wks.location}/bin/%{cfg.platform}/%{cfg.buildcfg}/",
+		"%{ml_copy} %{wks.location}/bin-lib/%{cfg.platform}/%{cfg.buildcfg}/lib%{prj.name}%{ml_dll} %{wks.location}/bin/%{cfg.platform}/%{cfg.buildcfg}/",
 	}
 
-filter{ "system:Windows", "configurations:Release" }
-	linkoptions{
-		"/NODEFAULTLIB:LIBCMT.lib"
+filter{ "system:linux", "options:with-osmesa" }
+	defines{
+		"ML_IMPL_HEADLESS_OSMESA",
+	}
+	links{
+		"OSMesa",
 	}
 
 -- * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * --
\ No newline at end of file
@@ -19,7 +19,6 @@ dependson{
 
 defines{
 	"_CRT_SECURE_NO_WARNINGS", "NOMINMAX",
-	"IMGUI_API=__declspec(dllimport)",
 }
 
 undefines{
@@ -42,7 +41,6 @@ libdirs{
 }
 
 links{
-	"opengl32",
 	"glfw",
 	"imgui",
 	"modus_core",
@@ -72,24 +70,54 @@ files{
 	"%{wks.location}/source/%{prj.name}/**.**",
 }
 
-postbuildcommands{
-	"%{ml_copy} %{wks.location}\\bin-lib\\%{cfg.platform}\\%{cfg.buildcfg}\\%{prj.name}%{ml_exe} %{wks.location}\\bin\\%{cfg.platform}\\%{cfg.buildcfg}\\",
-}
-
 filter{ "configurations:Debug" }
 	kind "ConsoleApp"
 	symbols "On"
+
+filter{ "configurations:Release" }
+	kind "WindowedApp"
+	optimize "Speed"
+
+-- WINDOWS
+
+filter{ "system:Windows" }
+	defines{
+		"IMGUI_API=__declspec(dllimport)",
+	}
+	links{
+		"opengl32",
+	}
+	postbuildcommands{
+		"%{ml_copy} %{wks.location}\\bin-lib\\%{cfg.platform}\\%{cfg.buildcfg}\\%{prj.name}%{ml_exe} %{wks.location}\\bin\\%{cfg.platform}\\%{cfg.buildcfg}\\",
+	}
+
+filter{ "system:Windows", "configurations:Debug" }
 	links{
 		"glew32d",
 		"python39_d",
 	}
 
-filter{ "configurations:Release" }
-	kind "WindowedApp"
-	optimize "Speed"
+filter{ "system:Windows", "configurations:Release" }
 	links{
 		"glew32",
 		"python39",
 	}
 
+-- LINUX
+
+filter{ "system:linux" }
+	kind "ConsoleApp"
+	links{
+		"GLEW",
+		"OpenGL",
+		"EGL",
+		"python3.9",
+		"dl",
+		"pthread",
+	}
+	postbuildcommands{
+		"mkdir -p %{wks.location}/bin/%{cfg.platform}/%{cfg.buildcfg}/",
+		"%{ml_copy} %{wks.location}/bin-lib/%{cfg.platform}/%{cfg.buildcfg}/%{prj.name}%{ml_exe} %{wks.location}/bin/%{cfg.platform}/%{cfg.buildcfg}/",
+	}
+
 -- * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * --
\ No newline at end of file
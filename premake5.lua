@@ -17,19 +17,29 @@ workspace "modus_%{_ACTION}"
 -- Commands
 -- * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * --
 
-filter{ "system:Unix", "system:Mac" }
-	ml_copy	= "cp -rf"
-	ml_move	= "mv -f"
-	ml_exe	= ".o"
-	ml_dll	= ".so"
-	ml_lib	= ".a"
-	
-filter{ "system:Windows" }
+-- filters do not apply to plain variables, so pick them by target
+if os.istarget("windows") then
 	ml_copy	= "xcopy /y"
 	ml_move	= "move /y"
 	ml_exe	= ".exe"
 	ml_dll	= ".dll"
 	ml_lib	= ".lib"
+else
+	ml_copy	= "cp -rf"
+	ml_move	= "mv -f"
+	ml_exe	= ""
+	ml_dll	= ".so"
+	ml_lib	= ".a"
+end
+
+-- * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * --
+-- Options
+-- * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * --
+
+newoption{
+	trigger		= "with-osmesa",
+	description	= "Build the OSMesa headless context as a fallback for EGL (Linux)",
+}
 
 -- * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * --
 -- Projects
@@ -0,0 +1,15 @@
+#ifndef _ML_EGL_HPP_
+#define _ML_EGL_HPP_
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <modus_core/Standard.hpp>
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#endif // !_ML_EGL_HPP_
\ No newline at end of file
@@ -0,0 +1,279 @@
+#ifdef ML_IMPL_HEADLESS_EGL
+
+#include "./EGL.hpp"
+#include "./EGL_Context.hpp"
+
+#include <mutex>
+
+// EGL CONTEXT
+namespace ml
+{
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	// extension strings are space separated names
+	static bool _has_extension(cstring list, cstring name) noexcept
+	{
+		if (!list || !name) { return false; }
+
+		size_t const length{ std::strlen(name) };
+
+		for (cstring it{ list }; (it = std::strstr(it, name)); it += length)
+		{
+			if ((it == list || it[-1] == ' ') && (it[length] == ' ' || it[length] == '\0')) { return true; }
+		}
+		return false;
+	}
+
+	// displays that need no window system come first,
+	// mesa surfaceless runs on llvmpipe, devices cover drivers without it
+	static EGLDisplay _get_display(int32 index) noexcept
+	{
+		cstring const client{ eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS) };
+
+		static auto const get_platform_display{ (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT") };
+
+		static auto const query_devices{ (PFNEGLQUERYDEVICESEXTPROC)eglGetProcAddress("eglQueryDevicesEXT") };
+
+		switch (index)
+		{
+		case 0: // surfaceless
+		{
+			if (!get_platform_display || !_has_extension(client, "EGL_MESA_platform_surfaceless")) { break; }
+
+			return get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+		}
+		case 1: // device
+		{
+			if (!get_platform_display || !query_devices || !_has_extension(client, "EGL_EXT_platform_device")) { break; }
+
+			EGLDeviceEXT device{};
+			EGLint count{};
+			if (!query_devices(1, &device, &count) || !count) { break; }
+
+			return get_platform_display(EGL_PLATFORM_DEVICE_EXT, device, nullptr);
+		}
+		case 2: // default
+		{
+			return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+		}
+		}
+		return EGL_NO_DISPLAY;
+	}
+
+	// eglInitialize is not reference counted, so each display is terminated with its last context
+	static std::mutex g_display_mutex{};
+
+	static std::map<EGLDisplay, size_t> g_display_refs{};
+
+	static bool _initialize_display(EGLDisplay display, EGLint & major, EGLint & minor) noexcept
+	{
+		std::unique_lock<std::mutex> lock{ g_display_mutex };
+		if (!eglInitialize(display, &major, &minor)) { return false; }
+		++g_display_refs[display];
+		return true;
+	}
+
+	static void _terminate_display(EGLDisplay display) noexcept
+	{
+		std::unique_lock<std::mutex> lock{ g_display_mutex };
+		if (auto const it{ g_display_refs.find(display) }; it != g_display_refs.end() && !--it->second)
+		{
+			g_display_refs.erase(it);
+			eglTerminate(display);
+		}
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	egl_context::egl_context(allocator_type alloc) noexcept
+		: m_display	{ EGL_NO_DISPLAY }
+		, m_config	{}
+		, m_surface	{ EGL_NO_SURFACE }
+		, m_context	{ EGL_NO_CONTEXT }
+		, m_size	{}
+	{
+	}
+
+	egl_context::~egl_context()
+	{
+		close();
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	bool egl_context::open(vec2i const & size, context_settings const & cs)
+	{
+		// check already open
+		if (is_open()) { return debug::fail("egl context is already open"); }
+
+		// size
+		m_size = { (std::max)(size[0], 1), (std::max)(size[1], 1) };
+
+		// display
+		EGLint major{}, minor{};
+		for (int32 i = 0; i < 3 && m_display == EGL_NO_DISPLAY; ++i)
+		{
+			if (EGLDisplay const d{ _get_display(i) }
+			; d != EGL_NO_DISPLAY && _initialize_display(d, major, minor))
+			{
+				m_display = d;
+			}
+		}
+		if (m_display == EGL_NO_DISPLAY) { return debug::fail("failed initializing egl display"); }
+
+		// api
+		if (!eglBindAPI(EGL_OPENGL_API))
+		{
+			close();
+			return debug::fail("egl display does not support desktop opengl");
+		}
+
+		// without surfaceless contexts a pbuffer stands in for the default framebuffer
+		bool const surfaceless{ _has_extension(eglQueryString(m_display, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context") };
+
+		// config
+		EGLint const config_attribs[]
+		{
+			EGL_SURFACE_TYPE,		surfaceless ? 0 : EGL_PBUFFER_BIT,
+			EGL_RENDERABLE_TYPE,	EGL_OPENGL_BIT,
+			EGL_RED_SIZE,			8,
+			EGL_GREEN_SIZE,			8,
+			EGL_BLUE_SIZE,			8,
+			EGL_ALPHA_SIZE,			8,
+			EGL_DEPTH_SIZE,			cs.depth_bits,
+			EGL_STENCIL_SIZE,		cs.stencil_bits,
+			EGL_NONE
+		};
+		EGLint count{};
+		if (!eglChooseConfig(m_display, config_attribs, (EGLConfig *)&m_config, 1, &count) || !count)
+		{
+			close();
+			return debug::fail("no matching egl config");
+		}
+
+		// the debug attribute is new in 1.5, older displays take it as a khr context flag
+		bool const egl15{ major > 1 || (major == 1 && minor >= 5) };
+
+		bool const create_context_khr{ _has_extension(eglQueryString(m_display, EGL_EXTENSIONS), "EGL_KHR_create_context") };
+
+		// context
+		auto const create_context = [&](int32 profile, bool versioned) -> EGLContext
+		{
+			EGLint context_attribs[9]{};
+			size_t n{};
+
+			context_attribs[n++] = EGL_CONTEXT_OPENGL_PROFILE_MASK;
+			context_attribs[n++] = (profile == context_profile_core)
+				? EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT
+				: EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT;
+
+			if (profile == context_profile_debug && egl15)
+			{
+				context_attribs[n++] = EGL_CONTEXT_OPENGL_DEBUG;
+				context_attribs[n++] = EGL_TRUE;
+			}
+			else if (profile == context_profile_debug && create_context_khr)
+			{
+				context_attribs[n++] = EGL_CONTEXT_FLAGS_KHR;
+				context_attribs[n++] = EGL_CONTEXT_OPENGL_DEBUG_BIT_KHR;
+			}
+
+			if (versioned)
+			{
+				context_attribs[n++] = EGL_CONTEXT_MAJOR_VERSION;
+				context_attribs[n++] = cs.major;
+				context_attribs[n++] = EGL_CONTEXT_MINOR_VERSION;
+				context_attribs[n++] = cs.minor;
+			}
+
+			context_attribs[n++] = EGL_NONE;
+
+			return eglCreateContext(m_display, m_config, EGL_NO_CONTEXT, context_attribs);
+		};
+
+		// llvmpipe stops short of 4.6 and only reaches recent versions through the core profile,
+		// so fall back to core, then to the newest version the driver offers
+		if ((m_context = create_context(cs.profile, true)) == EGL_NO_CONTEXT && cs.profile != context_profile_core)
+		{
+			m_context = create_context(context_profile_core, true);
+		}
+		if (m_context == EGL_NO_CONTEXT)
+		{
+			m_context = create_context(cs.profile, false);
+		}
+		if (m_context == EGL_NO_CONTEXT)
+		{
+			close();
+			return debug::fail("failed creating egl context {0}.{1}", cs.major, cs.minor);
+		}
+
+		// surface
+		if (!surfaceless)
+		{
+			EGLint const surface_attribs[]
+			{
+				EGL_WIDTH,	m_size[0],
+				EGL_HEIGHT,	m_size[1],
+				EGL_NONE
+			};
+			if ((m_surface = eglCreatePbufferSurface(m_display, m_config, surface_attribs)) == EGL_NO_SURFACE)
+			{
+				close();
+				return debug::fail("failed creating egl pbuffer");
+			}
+		}
+
+		// make current context
+		if (!make_current())
+		{
+			close();
+			return debug::fail("failed making egl context current");
+		}
+
+		// success
+		return true;
+	}
+
+	void egl_context::close()
+	{
+		if (m_display == EGL_NO_DISPLAY) { return; }
+
+		if (is_current()) { release_current(); }
+
+		if (m_surface != EGL_NO_SURFACE) { eglDestroySurface(m_display, m_surface); }
+
+		if (m_context != EGL_NO_CONTEXT) { eglDestroyContext(m_display, m_context); }
+
+		_terminate_display(m_display);
+
+		m_display = EGL_NO_DISPLAY;
+		m_config = {};
+		m_surface = EGL_NO_SURFACE;
+		m_context = EGL_NO_CONTEXT;
+		m_size = {};
+	}
+
+	bool egl_context::make_current()
+	{
+		return m_context != EGL_NO_CONTEXT
+			&& eglMakeCurrent(m_display, m_surface, m_surface, m_context);
+	}
+
+	void egl_context::release_current()
+	{
+		if (m_display == EGL_NO_DISPLAY) { return; }
+
+		eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	bool egl_context::is_current() const
+	{
+		return m_context != EGL_NO_CONTEXT && eglGetCurrentContext() == m_context;
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+}
+
+#endif // ML_IMPL_HEADLESS_EGL
\ No newline at end of file
@@ -0,0 +1,54 @@
+#ifndef _ML_EGL_CONTEXT_HPP_
+#define _ML_EGL_CONTEXT_HPP_
+
+#include <modus_core/window/HeadlessContext.hpp>
+
+namespace ml
+{
+	// egl headless context
+	struct egl_context final : base_headless_context
+	{
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		using base_headless_context::allocator_type;
+
+		egl_context(allocator_type alloc = {}) noexcept;
+
+		~egl_context() final;
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		bool open(vec2i const & size, context_settings const & cs = {}) final;
+
+		void close() final;
+
+		bool make_current() final;
+
+		void release_current() final;
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		int32 get_backend() const final { return headless_backend_egl; }
+
+		void * get_handle() const final { return m_context; }
+
+		vec2i get_size() const final { return m_size; }
+
+		bool is_current() const final;
+
+		bool is_open() const final { return m_context != nullptr; }
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	private:
+		void *	m_display	; // EGLDisplay
+		void *	m_config	; // EGLConfig
+		void *	m_surface	; // EGLSurface, none when surfaceless
+		void *	m_context	; // EGLContext
+		vec2i	m_size		; // pbuffer size
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+	};
+}
+
+#endif // !_ML_EGL_CONTEXT_HPP_
\ No newline at end of file
@@ -40,7 +40,11 @@
 
 // opengl init
 #ifndef ML_IMPL_OPENGL_INIT
-#	if defined(ML_IMPL_OPENGL_LOADER_GLEW)
+#	if defined(ML_IMPL_OPENGL_LOADER_GLEW) && (defined(ML_IMPL_HEADLESS_EGL) || defined(ML_IMPL_HEADLESS_OSMESA))
+//										glew, core functions only, glewInit fails without an x11 display
+#		define ML_IMPL_OPENGL_INIT()	((glewExperimental = true) && (glewContextInit() == GLEW_OK))
+
+#	elif defined(ML_IMPL_OPENGL_LOADER_GLEW)
 //										glew
 #		define ML_IMPL_OPENGL_INIT()	((glewExperimental = true) && (glewInit() == GLEW_OK))
 
@@ -107,6 +111,17 @@
 #define ML_glUniformMatrix3fv(l, n, transpose, ptr)	glUniformMatrix3fvARB( l, n, transpose, ptr )
 #define ML_glUniformMatrix4fv(l, n, transpose, ptr)	glUniformMatrix4fvARB( l, n, transpose, ptr )
 
+// program uniform functions
+#define ML_glGetActiveUniform(p, i, max, len, size, type, name)	glGetActiveUniform( p, i, max, len, size, type, name )
+#define ML_glProgramUniform1i(p, loc, x)						glProgramUniform1i( p, loc, x )
+#define ML_glProgramUniform1f(p, loc, x)						glProgramUniform1f( p, loc, x )
+#define ML_glProgramUniform2f(p, loc, x, y)						glProgramUniform2f( p, loc, x, y )
+#define ML_glProgramUniform3f(p, loc, x, y, z)					glProgramUniform3f( p, loc, x, y, z )
+#define ML_glProgramUniform4f(p, loc, x, y, z, w)				glProgramUniform4f( p, loc, x, y, z, w )
+#define ML_glProgramUniformMatrix2fv(p, l, n, transpose, ptr)	glProgramUniformMatrix2fv( p, l, n, transpose, ptr )
+#define ML_glProgramUniformMatrix3fv(p, l, n, transpose, ptr)	glProgramUniformMatrix3fv( p, l, n, transpose, ptr )
+#define ML_glProgramUniformMatrix4fv(p, l, n, transpose, ptr)	glProgramUniformMatrix4fv( p, l, n, transpose, ptr )
+
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 //  enums
@@ -349,6 +364,17 @@ namespace ml::gfx
 
 			case format_depth_stencil		: return GL_DEPTH_STENCIL;
 			case format_depth24_stencil8	: return GL_DEPTH24_STENCIL8;
+
+			case format_rg					: return GL_RG;
+			case format_r8					: return GL_R8;
+			case format_rg8					: return GL_RG8;
+			case format_rgba8				: return GL_RGBA8;
+			case format_r16f				: return GL_R16F;
+			case format_rg16f				: return GL_RG16F;
+			case format_rgba16f				: return GL_RGBA16F;
+			case format_r32f				: return GL_R32F;
+			case format_rg32f				: return GL_RG32F;
+			case format_rgba32f				: return GL_RGBA32F;
 			}
 		}
 		else if constexpr (convt{} == to_user{})
@@ -375,6 +401,17 @@ namespace ml::gfx
 
 			case GL_DEPTH_STENCIL			: return format_depth_stencil;
 			case GL_DEPTH24_STENCIL8		: return format_depth24_stencil8;
+
+			case GL_RG						: return format_rg;
+			case GL_R8						: return format_r8;
+			case GL_RG8						: return format_rg8;
+			case GL_RGBA8					: return format_rgba8;
+			case GL_R16F					: return format_r16f;
+			case GL_RG16F					: return format_rg16f;
+			case GL_RGBA16F					: return format_rgba16f;
+			case GL_R32F					: return format_r32f;
+			case GL_RG32F					: return format_rg32f;
+			case GL_RGBA32F					: return format_rgba32f;
 			}
 		}
 		else
@@ -507,6 +544,7 @@ namespace ml::gfx
 			case shader_type_vertex		: return GL_VERTEX_SHADER;
 			case shader_type_pixel	: return GL_FRAGMENT_SHADER;
 			case shader_type_geometry	: return GL_GEOMETRY_SHADER;
+			case shader_type_compute	: return GL_COMPUTE_SHADER;
 			}
 		}
 		else if constexpr (convt{} == to_user{})
@@ -517,6 +555,38 @@ namespace ml::gfx
 			case GL_VERTEX_SHADER	: return shader_type_vertex;
 			case GL_FRAGMENT_SHADER	: return shader_type_pixel;
 			case GL_GEOMETRY_SHADER	: return shader_type_geometry;
+			case GL_COMPUTE_SHADER	: return shader_type_compute;
+			}
+		}
+		else
+		{
+			static_assert(0, "invalid enum conversion");
+			return static_cast<uint32>(-1);
+		}
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	template <class convt> constexpr uint32 _image_access(uint32 value) noexcept
+	{
+		if constexpr (convt{} == to_impl{})
+		{
+			switch (value)
+			{
+			default						: return value;
+			case image_access_read		: return GL_READ_ONLY;
+			case image_access_write		: return GL_WRITE_ONLY;
+			case image_access_read_write: return GL_READ_WRITE;
+			}
+		}
+		else if constexpr (convt{} == to_user{})
+		{
+			switch (value)
+			{
+			default				: return value;
+			case GL_READ_ONLY	: return image_access_read;
+			case GL_WRITE_ONLY	: return image_access_write;
+			case GL_READ_WRITE	: return image_access_read_write;
 			}
 		}
 		else
@@ -539,6 +609,7 @@ namespace ml::gfx
 			case texture_type_2d	: return GL_TEXTURE_2D;
 			case texture_type_3d	: return GL_TEXTURE_3D;
 			case texture_type_cube	: return GL_TEXTURE_CUBE_MAP;
+			case texture_type_2d_array	: return GL_TEXTURE_2D_ARRAY;
 			}
 		}
 		else if constexpr (convt{} == to_user{})
@@ -550,6 +621,7 @@ namespace ml::gfx
 			case GL_TEXTURE_2D		: return texture_type_2d;
 			case GL_TEXTURE_3D		: return texture_type_3d;
 			case GL_TEXTURE_CUBE_MAP: return texture_type_cube;
+			case GL_TEXTURE_2D_ARRAY: return texture_type_2d_array;
 			}
 		}
 		else
@@ -5,6 +5,83 @@
 #define ML_IMPL_GFX_CHECK
 #include "./OpenGL.hpp"
 #include "./OpenGL_RenderAPI.hpp"
+#include <modus_core/graphics/CommandBuffer.hpp>
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+// state cache
+namespace ml::gfx
+{
+	// objects that bind or delete behind the context's back must drop its cached bindings
+	static void _invalidate_bindings(render_device * parent) noexcept
+	{
+		if (auto const & ctx{ parent->get_context() })
+		{
+			static_cast<opengl_render_context *>(ctx.get())->invalidate_bindings();
+		}
+	}
+
+	// counters of the frame in progress
+	static render_counters & _stats(render_device * parent) noexcept
+	{
+		return parent->get_frame_stats();
+	}
+
+	// make a texture resident once and keep its bindless handle
+	static uint64 _bindless_handle(render_device * parent, uint32 texture, uint64 & handle) noexcept
+	{
+		if (handle || !texture || !parent->get_info().bindless_textures_available) { return handle; }
+
+		ML_glCheck(handle = glGetTextureHandleARB(texture));
+		ML_glCheck(glMakeTextureHandleResidentARB(handle));
+		return handle;
+	}
+
+	// a texture must not be resident when it is deleted
+	static void _release_bindless(uint64 & handle) noexcept
+	{
+		if (!handle) { return; }
+
+		ML_glCheck(glMakeTextureHandleNonResidentARB(handle));
+		handle = 0;
+	}
+
+	// bytes in one element of a uniform type without std140 padding, zero for types the engine doesn't write
+	static uint32 _uniform_type_size(uint32 type) noexcept
+	{
+		switch (type)
+		{
+		default					: return 0;
+		case GL_BOOL			:
+		case GL_INT				:
+		case GL_UNSIGNED_INT	:
+		case GL_FLOAT			: return 4;
+		case GL_BOOL_VEC2		:
+		case GL_INT_VEC2		:
+		case GL_UNSIGNED_INT_VEC2:
+		case GL_FLOAT_VEC2		: return 8;
+		case GL_BOOL_VEC3		:
+		case GL_INT_VEC3		:
+		case GL_UNSIGNED_INT_VEC3:
+		case GL_FLOAT_VEC3		: return 12;
+		case GL_BOOL_VEC4		:
+		case GL_INT_VEC4		:
+		case GL_UNSIGNED_INT_VEC4:
+		case GL_FLOAT_VEC4		:
+		case GL_FLOAT_MAT2		: return 16;
+		case GL_FLOAT_MAT3		: return 36;
+		case GL_FLOAT_MAT4		: return 64;
+		}
+	}
+
+	// bytes in an image of the given format
+	static size_t _image_size(texture_format const & format, vec2i const & size) noexcept
+	{
+		size_t const channels{ (format.type == type_uint_24_8) ? 1 : get_format_channels(format.pixel) };
+
+		return (size_t)size[0] * (size_t)size[1] * channels * get_type_size(format.type);
+	}
+}
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
@@ -45,13 +122,10 @@ namespace ml::gfx
 			ML_glCheck(glGetIntegerv(GL_NUM_EXTENSIONS, &num));
 			m_info.extensions.reserve(num);
 
-			std::stringstream ss{};
-			ML_glCheck(ss.str((cstring)glGetString(GL_EXTENSIONS)));
-
-			string line{};
-			while (std::getline(ss, line, ' '))
+			// core profiles have no extension string, only indexed names
+			for (int32 i = 0; i < num; ++i)
 			{
-				m_info.extensions.push_back(line);
+				ML_glCheck(m_info.extensions.push_back((cstring)glGetStringi(GL_EXTENSIONS, (uint32)i)));
 			}
 		}
 
@@ -64,12 +138,26 @@ namespace ml::gfx
 		// max texture slots
 		ML_glCheck(glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, (int32 *)&m_info.max_texture_slots));
 
+		// max array texture layers
+		ML_glCheck(glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, (int32 *)&m_info.max_array_texture_layers));
+
+		// bindless textures available
+		m_info.bindless_textures_available = std::find(
+			m_info.extensions.begin(),
+			m_info.extensions.end(),
+			"GL_ARB_bindless_texture") != m_info.extensions.end();
+
 		// max color attachments
 		ML_glCheck(glGetIntegerv(GL_MAX_COLOR_ATTACHMENTS, (int32 *)&m_info.max_color_attachments));
 
 		// max samples
 		ML_glCheck(glGetIntegerv(GL_MAX_SAMPLES, (int32 *)&m_info.max_samples));
 
+		// uniform buffers
+		ML_glCheck(glGetIntegerv(GL_MAX_UNIFORM_BUFFER_BINDINGS, (int32 *)&m_info.max_uniform_buffer_bindings));
+		ML_glCheck(glGetIntegerv(GL_MAX_UNIFORM_BLOCK_SIZE, (int32 *)&m_info.max_uniform_block_size));
+		ML_glCheck(glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, (int32 *)&m_info.uniform_buffer_offset_alignment));
+
 		// shaders available
 #if defined(GL_ARB_shading_language_100) \
 || defined(GL_ARB_shader_objects) \
@@ -85,9 +173,162 @@ namespace ml::gfx
 		// shading language version
 		ML_glCheck(m_info.shading_language_version = (cstring)glGetString(GL_SHADING_LANGUAGE_VERSION));
 #endif
+
+		// program binaries available
+		{
+			int32 num{};
+			ML_glCheck(glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &num));
+			m_info.program_binaries_available = (0 < num);
+		}
+
+		// parallel shader compile available
+		m_info.parallel_shader_compile_available = std::find(
+			m_info.extensions.begin(),
+			m_info.extensions.end(),
+			"GL_KHR_parallel_shader_compile") != m_info.extensions.end();
+
+		// let the driver pick how many compiler threads to use
+		if (m_info.parallel_shader_compile_available)
+		{
+			ML_glCheck(glMaxShaderCompilerThreadsKHR(0xffffffff));
+		}
+
+		// compute shaders available
+		m_info.compute_shaders_available = (4 < m_info.major_version)
+			|| (4 == m_info.major_version && 3 <= m_info.minor_version)
+			|| std::find(
+				m_info.extensions.begin(),
+				m_info.extensions.end(),
+				"GL_ARB_compute_shader") != m_info.extensions.end();
+
+		if (m_info.compute_shaders_available)
+		{
+			// work group limits
+			for (uint32 i = 0; i < 3; ++i)
+			{
+				ML_glCheck(glGetIntegeri_v(GL_MAX_COMPUTE_WORK_GROUP_COUNT, i, (int32 *)&m_info.max_compute_work_group_count[i]));
+				ML_glCheck(glGetIntegeri_v(GL_MAX_COMPUTE_WORK_GROUP_SIZE, i, (int32 *)&m_info.max_compute_work_group_size[i]));
+			}
+			ML_glCheck(glGetIntegerv(GL_MAX_COMPUTE_WORK_GROUP_INVOCATIONS, (int32 *)&m_info.max_compute_work_group_invocations));
+
+			// storage buffers
+			ML_glCheck(glGetIntegerv(GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS, (int32 *)&m_info.max_storage_buffer_bindings));
+			ML_glCheck(glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, (int32 *)&m_info.storage_buffer_offset_alignment));
+
+			// image units
+			ML_glCheck(glGetIntegerv(GL_MAX_IMAGE_UNITS, (int32 *)&m_info.max_image_units));
+		}
+	}
+
+	opengl_render_device::~opengl_render_device()
+	{
+		if (auto const & v{ m_formats.values() }; !v.empty())
+		{
+			ML_glCheck(glDeleteVertexArrays((int32)v.size(), v.data()));
+		}
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	void opengl_render_device::flush_stats()
+	{
+		std::unique_lock<std::mutex> lock{ m_stats_mutex };
+		m_stats = m_frame_stats.exchange();
+	}
+
+	size_t opengl_render_device::poll_programs()
+	{
+		// the main thread keeps registering programs while the render thread polls
+		{
+			std::unique_lock<std::mutex> lock{ m_programs_mutex };
+			m_polled = all_programs();
+		}
+		size_t pending{};
+		for (auto const & e : m_polled)
+		{
+			if (auto const p{ e.lock() }; p && (p->poll() == program_status_compiling))
+			{
+				++pending;
+			}
+		}
+		m_polled.clear();
+		return pending;
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	// specify attribute formats of a layout on a binding point, matrices take one location per column
+	static void _set_format(uint32 vao, buffer_layout const & layout, uint32 binding, uint32 first) noexcept
+	{
+		uint32 location{ first };
+
+		for (auto const & e : layout.elements())
+		{
+			uint32 const type{ std::invoke([&]() noexcept -> uint32
+			{
+				switch (e.get_base_type())
+				{
+				default					: return 0			; // unknown
+				case hashof_v<bool>		: return GL_BOOL	; // bool
+				case hashof_v<int8>		: return GL_BYTE	; // byte
+				case hashof_v<int16>	: return GL_SHORT	; // short
+				case hashof_v<int32>	: return GL_INT		; // int
+				case hashof_v<float16>	: return GL_HALF_FLOAT; // half
+				case hashof_v<float32>	: return GL_FLOAT	; // float
+				case hashof_v<packed_2_10_10_10>: return GL_INT_2_10_10_10_REV; // packed
+				}
+			}) };
+
+			uint32 const columns{ e.get_column_count() };
+			uint32 const rows{ e.get_component_count() / columns };
+			uint32 const column_size{ e.size / columns };
+
+			for (uint32 i = 0; i < columns; ++i, ++location)
+			{
+				uint32 const offset{ e.offset + i * column_size };
+
+				if (type == GL_INT)
+				{
+					ML_glCheck(glVertexArrayAttribIFormat(vao, location, rows, type, offset));
+				}
+				else
+				{
+					ML_glCheck(glVertexArrayAttribFormat(vao, location, rows, type, e.normalized, offset));
+				}
+				ML_glCheck(glVertexArrayAttribBinding(vao, location, binding));
+				ML_glCheck(glEnableVertexArrayAttrib(vao, location));
+			}
+		}
+
+		// divisors belong to the binding point, taken from the layout's first element
+		if (!layout.elements().empty())
+		{
+			ML_glCheck(glVertexArrayBindingDivisor(vao, binding, layout.elements().front().divisor));
+		}
 	}
 
-	opengl_render_device::~opengl_render_device() {}
+	uint32 opengl_render_device::get_vertex_format(buffer_layout const & vertices, buffer_layout const * instances, buffer_layout const * stream, uint32 stream_location)
+	{
+		hash_t const key{ hash_fields(fnv1a_basis,
+			hash_layout(vertices),
+			instances ? hash_layout(*instances) : hash_t{},
+			stream ? hash_layout(*stream) : hash_t{},
+			stream ? stream_location : 0u) };
+
+		return m_formats.find_or_add_fn(key, [&]() noexcept
+		{
+			uint32 handle{};
+			ML_glCheck(glCreateVertexArrays(1, &handle));
+
+			_set_format(handle, vertices, vertex_binding_vertices, 0);
+
+			if (instances) { _set_format(handle, *instances, vertex_binding_instances, vertices.location_count()); }
+
+			if (stream) { _set_format(handle, *stream, vertex_binding_stream, stream_location); }
+
+			return handle;
+		});
+	}
 
 	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
@@ -128,6 +369,27 @@ namespace ml::gfx
 		return sp;
 	}
 
+	ref<uniformbuffer> opengl_render_device::new_uniformbuffer(spec<uniformbuffer> const & desc, allocator_type alloc) noexcept
+	{
+		auto sp{ alloc_ref<opengl_uniformbuffer>(alloc, this, desc) };
+		m_objs.push_back<weak<uniformbuffer>>(sp);
+		return sp;
+	}
+
+	ref<streambuffer> opengl_render_device::new_streambuffer(spec<streambuffer> const & desc, allocator_type alloc) noexcept
+	{
+		auto sp{ alloc_ref<opengl_streambuffer>(alloc, this, desc) };
+		m_objs.push_back<weak<streambuffer>>(sp);
+		return sp;
+	}
+
+	ref<storagebuffer> opengl_render_device::new_storagebuffer(spec<storagebuffer> const & desc, allocator_type alloc) noexcept
+	{
+		auto sp{ alloc_ref<opengl_storagebuffer>(alloc, this, desc) };
+		m_objs.push_back<weak<storagebuffer>>(sp);
+		return sp;
+	}
+
 	ref<texture2d> opengl_render_device::new_texture2d(spec<texture2d> const & desc, allocator_type alloc) noexcept
 	{
 		auto sp{ alloc_ref<opengl_texture2d>(alloc, this, desc) };
@@ -135,6 +397,13 @@ namespace ml::gfx
 		return sp;
 	}
 
+	ref<texture2d_array> opengl_render_device::new_texture2d_array(spec<texture2d_array> const & desc, allocator_type alloc) noexcept
+	{
+		auto sp{ alloc_ref<opengl_texture2d_array>(alloc, this, desc) };
+		m_objs.push_back<weak<texture2d_array>>(sp);
+		return sp;
+	}
+
 	ref<texture3d> opengl_render_device::new_texture3d(spec<texture3d> const & desc, allocator_type alloc) noexcept
 	{
 		auto sp{ alloc_ref<opengl_texture3d>(alloc, this, desc) };
@@ -159,6 +428,7 @@ namespace ml::gfx
 	ref<program> opengl_render_device::new_program(spec<program> const & desc, allocator_type alloc) noexcept
 	{
 		auto sp{ alloc_ref<opengl_program>(alloc, this, desc) };
+		std::unique_lock<std::mutex> lock{ m_programs_mutex };
 		m_objs.push_back<weak<program>>(sp);
 		return sp;
 	}
@@ -170,6 +440,13 @@ namespace ml::gfx
 		return sp;
 	}
 
+	ref<pipeline_state> opengl_render_device::new_pipeline_state(spec<pipeline_state> const & desc, allocator_type alloc) noexcept
+	{
+		auto sp{ alloc_ref<opengl_pipeline_state>(alloc, this, desc) };
+		m_objs.push_back<weak<pipeline_state>>(sp);
+		return sp;
+	}
+
 	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 }
 
@@ -184,7 +461,10 @@ namespace ml::gfx
 		: render_context{ parent }
 		, m_handle		{}
 		, m_desc		{ desc }
+		, m_cache		{}
 	{
+		m_cache.reset();
+
 		ML_verify("invalid render context api" && desc.api == context_api_opengl);
 
 		if (auto const major{ parent->get_info().major_version }; major != desc.major) {
@@ -215,199 +495,336 @@ namespace ml::gfx
 
 		ML_glCheck(glGenProgramPipelines(1, &m_handle));
 
+		m_cache.reset();
+
 		return (bool)m_handle;
 	}
 
 	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
+	void opengl_render_context::submit(command_buffer const & value)
+	{
+		// decode against the final type so every call resolves statically
+		value.execute(this);
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
 	alpha_state * opengl_render_context::get_alpha_state(alpha_state * value) const
 	{
 		if (static alpha_state temp{}; !value) { value = &temp; }
 
-		ML_glCheck(glGetBooleanv(GL_ALPHA_TEST, (uint8 *)&value->enabled));
+		if (auto & c{ m_cache.alpha }; !(m_cache.known & state_alpha))
+		{
+			ML_glCheck(glGetBooleanv(GL_ALPHA_TEST, (uint8 *)&c.enabled));
 
-		ML_glCheck(glGetIntegerv(GL_ALPHA_TEST_FUNC, (int32 *)&value->pred));
-		value->pred = _predicate<to_user>(value->pred);
+			ML_glCheck(glGetIntegerv(GL_ALPHA_TEST_FUNC, (int32 *)&c.pred));
+			c.pred = _predicate<to_user>(c.pred);
 
-		ML_glCheck(glGetFloatv(GL_ALPHA_TEST_REF, &value->ref));
+			ML_glCheck(glGetFloatv(GL_ALPHA_TEST_REF, &c.ref));
 
-		return value;
+			m_cache.known |= state_alpha;
+		}
+		return &(*value = m_cache.alpha);
 	}
 
 	blend_state * opengl_render_context::get_blend_state(blend_state * value) const
 	{
 		if (static blend_state temp{}; !value) { value = &temp; }
 
-		ML_glCheck(glGetBooleanv(GL_BLEND, (uint8 *)&value->enabled));
+		if (auto & c{ m_cache.blend }; !(m_cache.known & state_blend))
+		{
+			ML_glCheck(glGetBooleanv(GL_BLEND, (uint8 *)&c.enabled));
 
-		ML_glCheck(glGetFloatv(GL_BLEND_COLOR, value->color));
+			ML_glCheck(glGetFloatv(GL_BLEND_COLOR, c.color));
 
-		ML_glCheck(glGetIntegerv(GL_BLEND_EQUATION_RGB, (int32 *)&value->color_equation));
-		value->color_equation = _equation<to_user>(value->color_equation);
+			ML_glCheck(glGetIntegerv(GL_BLEND_EQUATION_RGB, (int32 *)&c.color_equation));
+			c.color_equation = _equation<to_user>(c.color_equation);
 
-		ML_glCheck(glGetIntegerv(GL_BLEND_SRC_RGB, (int32 *)&value->color_sfactor));
-		value->color_sfactor = _factor<to_user>(value->color_sfactor);
+			ML_glCheck(glGetIntegerv(GL_BLEND_SRC_RGB, (int32 *)&c.color_sfactor));
+			c.color_sfactor = _factor<to_user>(c.color_sfactor);
 
-		ML_glCheck(glGetIntegerv(GL_BLEND_DST_RGB, (int32 *)&value->color_dfactor));
-		value->color_dfactor = _factor<to_user>(value->color_dfactor);
+			ML_glCheck(glGetIntegerv(GL_BLEND_DST_RGB, (int32 *)&c.color_dfactor));
+			c.color_dfactor = _factor<to_user>(c.color_dfactor);
 
-		ML_glCheck(glGetIntegerv(GL_BLEND_EQUATION_ALPHA, (int32 *)&value->alpha_equation));
-		value->alpha_equation = _equation<to_user>(value->alpha_equation);
+			ML_glCheck(glGetIntegerv(GL_BLEND_EQUATION_ALPHA, (int32 *)&c.alpha_equation));
+			c.alpha_equation = _equation<to_user>(c.alpha_equation);
 
-		ML_glCheck(glGetIntegerv(GL_BLEND_SRC_ALPHA, (int32 *)&value->alpha_sfactor));
-		value->alpha_sfactor = _factor<to_user>(value->alpha_sfactor);
+			ML_glCheck(glGetIntegerv(GL_BLEND_SRC_ALPHA, (int32 *)&c.alpha_sfactor));
+			c.alpha_sfactor = _factor<to_user>(c.alpha_sfactor);
 
-		ML_glCheck(glGetIntegerv(GL_BLEND_DST_ALPHA, (int32 *)&value->alpha_dfactor));
-		value->alpha_dfactor = _factor<to_user>(value->alpha_dfactor);
+			ML_glCheck(glGetIntegerv(GL_BLEND_DST_ALPHA, (int32 *)&c.alpha_dfactor));
+			c.alpha_dfactor = _factor<to_user>(c.alpha_dfactor);
 
-		return value;
+			m_cache.known |= state_blend;
+		}
+		return &(*value = m_cache.blend);
 	}
 
 	color * opengl_render_context::get_clear_color(color * value) const
 	{
 		if (static color temp{}; !value) { value = &temp; }
 
-		ML_glCheck(glGetFloatv(GL_COLOR_CLEAR_VALUE, *value));
+		if (!(m_cache.known & state_clear_color))
+		{
+			ML_glCheck(glGetFloatv(GL_COLOR_CLEAR_VALUE, m_cache.clear_color));
 
-		return value;
+			m_cache.known |= state_clear_color;
+		}
+		return &(*value = m_cache.clear_color);
 	}
 
 	cull_state * opengl_render_context::get_cull_state(cull_state * value) const
 	{
 		if (static cull_state temp{}; !value) { value = &temp; }
 
-		ML_glCheck(glGetBooleanv(GL_CULL_FACE, (uint8 *)&value->enabled));
+		if (auto & c{ m_cache.cull }; !(m_cache.known & state_cull))
+		{
+			ML_glCheck(glGetBooleanv(GL_CULL_FACE, (uint8 *)&c.enabled));
 
-		ML_glCheck(glGetIntegerv(GL_CULL_FACE_MODE, (int32 *)&value->facet));
-		value->facet = _facet<to_user>(value->facet);
+			ML_glCheck(glGetIntegerv(GL_CULL_FACE_MODE, (int32 *)&c.facet));
+			c.facet = _facet<to_user>(c.facet);
 
-		ML_glCheck(glGetIntegerv(GL_FRONT_FACE, (int32 *)&value->order));
-		value->order = _order<to_user>(value->order);
+			ML_glCheck(glGetIntegerv(GL_FRONT_FACE, (int32 *)&c.order));
+			c.order = _order<to_user>(c.order);
 
-		return value;
+			m_cache.known |= state_cull;
+		}
+		return &(*value = m_cache.cull);
 	}
 
 	depth_state * opengl_render_context::get_depth_state(depth_state * value) const
 	{
 		if (static depth_state temp{}; !value) { value = &temp; }
 
-		ML_glCheck(glGetBooleanv(GL_DEPTH_TEST, (uint8 *)&value->enabled));
+		if (auto & c{ m_cache.depth }; !(m_cache.known & state_depth))
+		{
+			ML_glCheck(glGetBooleanv(GL_DEPTH_TEST, (uint8 *)&c.enabled));
 
-		ML_glCheck(glGetIntegerv(GL_DEPTH_FUNC, (int32 *)&value->pred));
-		value->pred = _predicate<to_user>(value->pred);
-		
-		ML_glCheck(glGetFloatv(GL_DEPTH_RANGE, value->range));
-		
-		return value;
+			ML_glCheck(glGetIntegerv(GL_DEPTH_FUNC, (int32 *)&c.pred));
+			c.pred = _predicate<to_user>(c.pred);
+
+			ML_glCheck(glGetFloatv(GL_DEPTH_RANGE, c.range));
+
+			m_cache.known |= state_depth;
+		}
+		return &(*value = m_cache.depth);
 	}
 
 	stencil_state * opengl_render_context::get_stencil_state(stencil_state * value) const
 	{
 		if (static stencil_state temp{}; !value) { value = &temp; }
 
-		ML_glCheck(glGetBooleanv(GL_STENCIL_TEST, (uint8 *)&value->enabled));
+		if (auto & c{ m_cache.stencil }; !(m_cache.known & state_stencil))
 		{
-			ML_glCheck(glGetIntegerv(GL_STENCIL_FUNC, (int32 *)&value->front_pred));
-			value->front_pred = _predicate<to_user>(value->front_pred);
+			ML_glCheck(glGetBooleanv(GL_STENCIL_TEST, (uint8 *)&c.enabled));
+			{
+				ML_glCheck(glGetIntegerv(GL_STENCIL_FUNC, (int32 *)&c.front_pred));
+				c.front_pred = _predicate<to_user>(c.front_pred);
 
-			ML_glCheck(glGetIntegerv(GL_STENCIL_REF, &value->front_ref));
+				ML_glCheck(glGetIntegerv(GL_STENCIL_REF, &c.front_ref));
 
-			ML_glCheck(glGetIntegerv(GL_STENCIL_VALUE_MASK, (int32 *)&value->front_mask));
-		}
-		{
-			ML_glCheck(glGetIntegerv(GL_STENCIL_BACK_FUNC, (int32 *)&value->back_pred));
-			value->back_pred = _predicate<to_user>(value->back_pred);
+				ML_glCheck(glGetIntegerv(GL_STENCIL_VALUE_MASK, (int32 *)&c.front_mask));
+			}
+			{
+				ML_glCheck(glGetIntegerv(GL_STENCIL_BACK_FUNC, (int32 *)&c.back_pred));
+				c.back_pred = _predicate<to_user>(c.back_pred);
 
-			ML_glCheck(glGetIntegerv(GL_STENCIL_BACK_REF, &value->back_ref));
+				ML_glCheck(glGetIntegerv(GL_STENCIL_BACK_REF, &c.back_ref));
 
-			ML_glCheck(glGetIntegerv(GL_STENCIL_BACK_VALUE_MASK, (int32 *)&value->back_mask));
-		}
+				ML_glCheck(glGetIntegerv(GL_STENCIL_BACK_VALUE_MASK, (int32 *)&c.back_mask));
+			}
 
-		return value;
+			m_cache.known |= state_stencil;
+		}
+		return &(*value = m_cache.stencil);
 	}
 
 	int_rect * opengl_render_context::get_viewport(int_rect * value) const
 	{
 		if (static int_rect temp{}; !value) { value = &temp; }
 
-		ML_glCheck(glGetIntegerv(GL_VIEWPORT, *value));
+		if (!(m_cache.known & state_viewport))
+		{
+			ML_glCheck(glGetIntegerv(GL_VIEWPORT, m_cache.viewport));
 
-		return value;
+			m_cache.known |= state_viewport;
+		}
+		return &(*value = m_cache.viewport);
 	}
 
 	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 	void opengl_render_context::set_alpha_state(alpha_state const & value)
 	{
-		ML_glCheck(ML_glEnable(GL_ALPHA_TEST, value.enabled));
+		bool const known{ (bool)(m_cache.known & state_alpha) };
+		alpha_state & c{ m_cache.alpha };
+
+		if (!known || c.enabled != value.enabled)
+		{
+			ML_glCheck(ML_glEnable(GL_ALPHA_TEST, value.enabled));
+		}
+
+		if (!known || c.pred != value.pred || c.ref != value.ref)
+		{
+			ML_glCheck(glAlphaFunc(_predicate<to_impl>(value.pred), value.ref));
+		}
 
-		ML_glCheck(glAlphaFunc(_predicate<to_impl>(value.pred), value.ref));
+		c = value;
+		m_cache.known |= state_alpha;
+		m_cache.pipeline.alpha = 0;
+		m_cache.pso = nullptr;
 	}
 
 	void opengl_render_context::set_blend_state(blend_state const & value)
 	{
-		ML_glCheck(ML_glEnable(GL_BLEND, value.enabled));
-		
-		ML_glCheck(glBlendColor(
-			value.color[0],
-			value.color[1],
-			value.color[2],
-			value.color[3]));
-		
-		ML_glCheck(glBlendFuncSeparate(
-			_factor<to_impl>(value.color_sfactor),
-			_factor<to_impl>(value.color_dfactor),
-			_factor<to_impl>(value.alpha_sfactor),
-			_factor<to_impl>(value.alpha_dfactor)));
+		bool const known{ (bool)(m_cache.known & state_blend) };
+		blend_state & c{ m_cache.blend };
+
+		if (!known || c.enabled != value.enabled)
+		{
+			ML_glCheck(ML_glEnable(GL_BLEND, value.enabled));
+		}
+
+		if (!known || c.color.rgba() != value.color.rgba())
+		{
+			ML_glCheck(glBlendColor(
+				value.color[0],
+				value.color[1],
+				value.color[2],
+				value.color[3]));
+		}
+
+		if (!known ||
+			c.color_sfactor != value.color_sfactor || c.color_dfactor != value.color_dfactor ||
+			c.alpha_sfactor != value.alpha_sfactor || c.alpha_dfactor != value.alpha_dfactor)
+		{
+			ML_glCheck(glBlendFuncSeparate(
+				_factor<to_impl>(value.color_sfactor),
+				_factor<to_impl>(value.color_dfactor),
+				_factor<to_impl>(value.alpha_sfactor),
+				_factor<to_impl>(value.alpha_dfactor)));
+		}
+
+		if (!known || c.color_equation != value.color_equation || c.alpha_equation != value.alpha_equation)
+		{
+			ML_glCheck(glBlendEquationSeparate(
+				_equation<to_impl>(value.color_equation),
+				_equation<to_impl>(value.alpha_equation)));
+		}
 
-		ML_glCheck(glBlendEquationSeparate(
-			_equation<to_impl>(value.color_equation),
-			_equation<to_impl>(value.alpha_equation)));
+		c = value;
+		m_cache.known |= state_blend;
+		m_cache.pipeline.blend = 0;
+		m_cache.pso = nullptr;
 	}
 
 	void opengl_render_context::set_clear_color(color const & value)
 	{
+		if ((m_cache.known & state_clear_color) && (m_cache.clear_color.rgba() == value.rgba())) { return; }
+
 		ML_glCheck(glClearColor(value[0], value[1], value[2], value[3]));
+
+		m_cache.clear_color = value;
+		m_cache.known |= state_clear_color;
 	}
 
 	void opengl_render_context::set_cull_state(cull_state const & value)
 	{
-		ML_glCheck(ML_glEnable(GL_CULL_FACE, value.enabled));
-		
-		ML_glCheck(glCullFace(_facet<to_impl>(value.facet)));
-		
-		ML_glCheck(glFrontFace(_order<to_impl>(value.order)));
+		bool const known{ (bool)(m_cache.known & state_cull) };
+		cull_state & c{ m_cache.cull };
+
+		if (!known || c.enabled != value.enabled)
+		{
+			ML_glCheck(ML_glEnable(GL_CULL_FACE, value.enabled));
+		}
+
+		if (!known || c.facet != value.facet)
+		{
+			ML_glCheck(glCullFace(_facet<to_impl>(value.facet)));
+		}
+
+		if (!known || c.order != value.order)
+		{
+			ML_glCheck(glFrontFace(_order<to_impl>(value.order)));
+		}
+
+		c = value;
+		m_cache.known |= state_cull;
+		m_cache.pipeline.cull = 0;
+		m_cache.pso = nullptr;
 	}
 
 	void opengl_render_context::set_depth_state(depth_state const & value)
 	{
-		ML_glCheck(ML_glEnable(GL_DEPTH_TEST, value.enabled));
-		
-		ML_glCheck(glDepthFunc(_predicate<to_impl>(value.pred)));
+		bool const known{ (bool)(m_cache.known & state_depth) };
+		depth_state & c{ m_cache.depth };
+
+		if (!known || c.enabled != value.enabled)
+		{
+			ML_glCheck(ML_glEnable(GL_DEPTH_TEST, value.enabled));
+		}
+
+		if (!known || c.pred != value.pred)
+		{
+			ML_glCheck(glDepthFunc(_predicate<to_impl>(value.pred)));
+		}
+
+		if (!known || c.range != value.range)
+		{
+			ML_glCheck(glDepthRangef(value.range[0], value.range[1]));
+		}
 
-		ML_glCheck(glDepthRangef(value.range[0], value.range[1]));
+		c = value;
+		m_cache.known |= state_depth;
+		m_cache.pipeline.depth = 0;
+		m_cache.pso = nullptr;
 	}
 
 	void opengl_render_context::set_stencil_state(stencil_state const & value)
 	{
-		ML_glCheck(ML_glEnable(GL_STENCIL_TEST, value.enabled));
+		bool const known{ (bool)(m_cache.known & state_stencil) };
+		stencil_state & c{ m_cache.stencil };
 
-		ML_glCheck(glStencilFuncSeparate(
-			GL_FRONT,
-			_predicate<to_impl>(value.front_pred),
-			value.front_ref,
-			value.front_mask));
-		
-		ML_glCheck(glStencilFuncSeparate(
-			GL_BACK,
-			_predicate<to_impl>(value.back_pred),
-			value.back_ref,
-			value.back_mask));
+		if (!known || c.enabled != value.enabled)
+		{
+			ML_glCheck(ML_glEnable(GL_STENCIL_TEST, value.enabled));
+		}
+
+		if (!known || c.front_pred != value.front_pred || c.front_ref != value.front_ref || c.front_mask != value.front_mask)
+		{
+			ML_glCheck(glStencilFuncSeparate(
+				GL_FRONT,
+				_predicate<to_impl>(value.front_pred),
+				value.front_ref,
+				value.front_mask));
+		}
+
+		if (!known || c.back_pred != value.back_pred || c.back_ref != value.back_ref || c.back_mask != value.back_mask)
+		{
+			ML_glCheck(glStencilFuncSeparate(
+				GL_BACK,
+				_predicate<to_impl>(value.back_pred),
+				value.back_ref,
+				value.back_mask));
+		}
+
+		c = value;
+		m_cache.known |= state_stencil;
+		m_cache.pipeline.stencil = 0;
+		m_cache.pso = nullptr;
 	}
 
 	void opengl_render_context::set_viewport(int_rect const & value)
 	{
+		using storage_type = typename int_rect::storage_type;
+
+		if ((m_cache.known & state_viewport) && ((storage_type const &)m_cache.viewport == (storage_type const &)value)) { return; }
+
 		ML_glCheck(glViewport(value[0], value[1], value[2], value[3]));
+
+		m_cache.viewport = value;
+		m_cache.known |= state_viewport;
 	}
 
 	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
@@ -421,23 +838,21 @@ namespace ml::gfx
 		ML_glCheck(glClear(temp));
 	}
 
-	void opengl_render_context::draw(ref<vertexarray> const & value)
+	void opengl_render_context::draw(vertexarray const * value)
 	{
-		// could be moved into header file
-
 		if (!value || value->get_vertices().empty()) { return; }
 
-		bind_vertexarray(value.get());
+		bind_vertexarray(value);
 
 		primitive_ const mode{ value->get_mode() };
 
+		uint32 const stride{ value->get_layout().stride() };
+
 		if (auto const & ib{ value->get_indices() })
 		{
-			bind_indexbuffer(ib.get());
-
 			for (auto const & vb : value->get_vertices())
 			{
-				bind_vertexbuffer(vb.get());
+				bind_vertex_buffer(vertex_binding_vertices, ML_handle(uint32, vb->get_handle()), stride);
 
 				draw_indexed(mode, ib->get_count());
 			}
@@ -446,7 +861,7 @@ namespace ml::gfx
 		{
 			for (auto const & vb : value->get_vertices())
 			{
-				bind_vertexbuffer(vb.get());
+				bind_vertex_buffer(vertex_binding_vertices, ML_handle(uint32, vb->get_handle()), stride);
 
 				draw_arrays(mode, 0, vb->get_count());
 			}
@@ -455,61 +870,412 @@ namespace ml::gfx
 
 	void opengl_render_context::draw_arrays(uint32 prim, size_t first, size_t count)
 	{
+		render_counters & stats{ _stats(get_device()) };
+		render_counters::add(stats.draw_calls);
+		render_counters::add(stats.primitives, get_primitive_count(prim, count));
+
 		ML_glCheck(glDrawArrays(_primitive<to_impl>(prim), (uint32)first, (uint32)count));
 	}
 
 	void opengl_render_context::draw_indexed(uint32 prim, size_t count)
 	{
-		ML_glCheck(glDrawElements(_primitive<to_impl>(prim), (uint32)count, GL_UNSIGNED_INT, nullptr));
+		render_counters & stats{ _stats(get_device()) };
+		render_counters::add(stats.draw_calls);
+		render_counters::add(stats.primitives, get_primitive_count(prim, count));
+
+		ML_glCheck(glDrawElements(_primitive<to_impl>(prim), (uint32)count, _type<to_impl>(m_cache.index_type), nullptr));
 	}
 
-	void opengl_render_context::flush()
+	void opengl_render_context::draw_instanced(vertexarray const * value, size_t instances, size_t first_instance)
 	{
-		ML_glCheck(glFlush());
-	}
+		if (!value || !instances || value->get_vertices().empty()) { return; }
 
-	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+		bind_vertexarray(value);
 
-	void opengl_render_context::bind_vertexarray(vertexarray const * value)
-	{
-		ML_glCheck(glBindVertexArray(value ? ML_handle(uint32, value->get_handle()) : NULL));
+		primitive_ const mode{ value->get_mode() };
+
+		if (auto const & ib{ value->get_indices() })
+		{
+			draw_indexed_instanced(mode, ib->get_count(), instances, first_instance);
+		}
+		else
+		{
+			size_t const stride{ (std::max)((size_t)value->get_layout().stride(), (size_t)1) };
+
+			draw_arrays_instanced(mode, 0, value->get_vertices().front()->get_size() / stride, instances, first_instance);
+		}
 	}
 
-	void opengl_render_context::bind_vertexbuffer(vertexbuffer const * value)
+	void opengl_render_context::draw_arrays_instanced(uint32 prim, size_t first, size_t count, size_t instances, size_t first_instance)
 	{
-		ML_glCheck(glBindBuffer(GL_ARRAY_BUFFER, value ? ML_handle(uint32, value->get_handle()) : NULL));
+		render_counters & stats{ _stats(get_device()) };
+		render_counters::add(stats.draw_calls);
+		render_counters::add(stats.primitives, get_primitive_count(prim, count) * instances);
+
+		ML_glCheck(glDrawArraysInstancedBaseInstance(_primitive<to_impl>(prim), (int32)first, (int32)count, (int32)instances, (uint32)first_instance));
 	}
 
-	void opengl_render_context::bind_indexbuffer(indexbuffer const * value)
+	void opengl_render_context::draw_indexed_instanced(uint32 prim, size_t count, size_t instances, size_t first_instance)
 	{
-		ML_glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, value ? ML_handle(uint32, value->get_handle()) : NULL));
+		render_counters & stats{ _stats(get_device()) };
+		render_counters::add(stats.draw_calls);
+		render_counters::add(stats.primitives, get_primitive_count(prim, count) * instances);
+
+		ML_glCheck(glDrawElementsInstancedBaseInstance(_primitive<to_impl>(prim), (int32)count, _type<to_impl>(m_cache.index_type), nullptr, (int32)instances, (uint32)first_instance));
 	}
 
-	void opengl_render_context::bind_texture(texture const * value, uint32 slot)
+	void opengl_render_context::draw_indexed_indirect(uint32 prim, streambuffer const * buffer, size_t offset, size_t count)
 	{
-		ML_glCheck(glBindTextureUnit(slot, value ? ML_handle(uint32, value->get_handle()) : NULL));
+		if (!buffer || !count) { return; }
+
+		// primitive counts live in gpu memory, only the call is counted
+		render_counters::add(_stats(get_device()).draw_calls);
+
+		bind_indirect_buffer(ML_handle(uint32, buffer->get_handle()));
+
+		ML_glCheck(glMultiDrawElementsIndirect(
+			_primitive<to_impl>(prim),
+			_type<to_impl>(m_cache.index_type),
+			reinterpret_cast<addr_t>(offset),
+			(int32)count,
+			(int32)sizeof(draw_indirect_command)));
 	}
 
-	void opengl_render_context::bind_framebuffer(framebuffer const * value)
+	void opengl_render_context::draw_indexed_indirect(uint32 prim, storagebuffer const * buffer, size_t offset, size_t count)
 	{
-		if (value)
-		{
-			ML_glCheck(glBindFramebuffer(GL_FRAMEBUFFER, ML_handle(uint32, value->get_handle())));
+		if (!buffer || !count) { return; }
 
-			set_viewport({ {}, value->get_size() });
-		}
-		else
-		{
-			ML_glCheck(glBindFramebuffer(GL_FRAMEBUFFER, NULL));
-		}
+		render_counters::add(_stats(get_device()).draw_calls);
+
+		bind_indirect_buffer(ML_handle(uint32, buffer->get_handle()));
+
+		ML_glCheck(glMultiDrawElementsIndirect(
+			_primitive<to_impl>(prim),
+			_type<to_impl>(m_cache.index_type),
+			reinterpret_cast<addr_t>(offset),
+			(int32)count,
+			(int32)sizeof(draw_indirect_command)));
 	}
 
-	void opengl_render_context::bind_program(program const * value)
+	void opengl_render_context::bind_indirect_buffer(uint32 handle)
 	{
-		ML_glCheck(ML_glUseProgram(value ? ML_handle(uint32, value->get_handle()) : NULL));
+		if (m_cache.dib == handle) { return; }
+
+		ML_glCheck(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_cache.dib = handle));
 	}
 
-	void opengl_render_context::bind_shader(shader const * value)
+	void opengl_render_context::flush()
+	{
+		ML_glCheck(glFlush());
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	void opengl_render_context::dispatch(uint32 x, uint32 y, uint32 z)
+	{
+		if (!x || !y || !z) { return; }
+
+		render_counters::add(_stats(get_device()).dispatches);
+
+		ML_glCheck(glDispatchCompute(x, y, z));
+	}
+
+	void opengl_render_context::dispatch_indirect(storagebuffer const * buffer, size_t offset)
+	{
+		if (!buffer) { return; }
+
+		render_counters::add(_stats(get_device()).dispatches);
+
+		if (uint32 const handle{ ML_handle(uint32, buffer->get_handle()) }; m_cache.dsp != handle)
+		{
+			ML_glCheck(glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, m_cache.dsp = handle));
+		}
+
+		ML_glCheck(glDispatchComputeIndirect((intptr_t)offset));
+	}
+
+	void opengl_render_context::memory_barrier(uint32 mask)
+	{
+		if (mask == barrier_flags_all) { ML_glCheck(glMemoryBarrier(GL_ALL_BARRIER_BITS)); return; }
+
+		uint32 temp{};
+		ML_flag_map(temp, GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT	, mask, barrier_flags_vertices	);
+		ML_flag_map(temp, GL_ELEMENT_ARRAY_BARRIER_BIT			, mask, barrier_flags_indices	);
+		ML_flag_map(temp, GL_UNIFORM_BARRIER_BIT				, mask, barrier_flags_uniforms	);
+		ML_flag_map(temp, GL_TEXTURE_FETCH_BARRIER_BIT			, mask, barrier_flags_textures	);
+		ML_flag_map(temp, GL_SHADER_IMAGE_ACCESS_BARRIER_BIT	, mask, barrier_flags_images	);
+		ML_flag_map(temp, GL_COMMAND_BARRIER_BIT				, mask, barrier_flags_commands	);
+		ML_flag_map(temp, GL_BUFFER_UPDATE_BARRIER_BIT			, mask, barrier_flags_buffers	);
+		ML_flag_map(temp, GL_FRAMEBUFFER_BARRIER_BIT			, mask, barrier_flags_framebuffer);
+		ML_flag_map(temp, GL_SHADER_STORAGE_BARRIER_BIT			, mask, barrier_flags_storage	);
+		if (temp) { ML_glCheck(glMemoryBarrier(temp)); }
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	sync_id opengl_render_context::insert_fence()
+	{
+		GLsync sync;
+		ML_glCheck(sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+		return (sync_id)sync;
+	}
+
+	bool opengl_render_context::wait_fence(sync_id value, uint64 timeout)
+	{
+		if (!value) { return true; }
+		uint32 result;
+		ML_glCheck(result = glClientWaitSync((GLsync)value, GL_SYNC_FLUSH_COMMANDS_BIT, timeout));
+		return (result == GL_ALREADY_SIGNALED) || (result == GL_CONDITION_SATISFIED);
+	}
+
+	void opengl_render_context::delete_fence(sync_id value)
+	{
+		if (value) { ML_glCheck(glDeleteSync((GLsync)value)); }
+	}
+
+	query_id opengl_render_context::new_query()
+	{
+		uint32 handle{};
+		ML_glCheck(glCreateQueries(GL_TIMESTAMP, 1, &handle));
+		return ML_handle(query_id, handle);
+	}
+
+	void opengl_render_context::delete_query(query_id value)
+	{
+		if (uint32 const handle{ ML_handle(uint32, value) }) { ML_glCheck(glDeleteQueries(1, &handle)); }
+	}
+
+	void opengl_render_context::query_timestamp(query_id value)
+	{
+		ML_glCheck(glQueryCounter(ML_handle(uint32, value), GL_TIMESTAMP));
+	}
+
+	bool opengl_render_context::get_query_result(query_id value, uint64 & result)
+	{
+		uint32 const handle{ ML_handle(uint32, value) };
+		int32 available{};
+		ML_glCheck(glGetQueryObjectiv(handle, GL_QUERY_RESULT_AVAILABLE, &available));
+		if (!available) { return false; }
+		ML_glCheck(glGetQueryObjectui64v(handle, GL_QUERY_RESULT, &result));
+		return true;
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	void opengl_render_context::bind_vertexarray(vertexarray const * value)
+	{
+		uint32 const handle{ value ? ML_handle(uint32, value->get_handle()) : NULL };
+
+		if (m_cache.vao != handle)
+		{
+			ML_glCheck(glBindVertexArray(m_cache.vao = handle));
+
+			render_counters::add(_stats(get_device()).vertexarray_binds);
+
+			// element and vertex buffer bindings belong to the vertexarray object
+			m_cache.ibo = state_cache::unknown;
+			std::fill(std::begin(m_cache.vertex_buffers), std::end(m_cache.vertex_buffers), state_cache::unknown);
+		}
+
+		if (!value) { return; }
+
+		// vertexarrays of the same format share an object, only their buffers are swapped
+		auto const va{ static_cast<opengl_vertexarray const *>(value) };
+
+		if (auto const & vertices{ va->get_vertices() }; !vertices.empty())
+		{
+			bind_vertex_buffer(vertex_binding_vertices, ML_handle(uint32, vertices.front()->get_handle()), va->get_layout().stride());
+		}
+
+		if (auto const & instances{ va->get_instances() })
+		{
+			bind_vertex_buffer(vertex_binding_instances, ML_handle(uint32, instances->get_handle()), va->get_instance_layout().stride());
+		}
+
+		if (auto const & stream{ va->get_stream() })
+		{
+			bind_vertex_buffer(vertex_binding_stream, ML_handle(uint32, stream->get_handle()), va->get_stream_layout().stride());
+		}
+
+		if (auto const & indices{ va->get_indices() })
+		{
+			bind_indexbuffer(indices.get());
+		}
+	}
+
+	void opengl_render_context::bind_vertex_buffer(uint32 binding, uint32 handle, uint32 stride)
+	{
+		if (m_cache.vertex_buffers[binding] == handle) { return; }
+
+		ML_glCheck(glBindVertexBuffer(binding, m_cache.vertex_buffers[binding] = handle, 0, (int32)stride));
+	}
+
+	void opengl_render_context::bind_vertexbuffer(vertexbuffer const * value)
+	{
+		uint32 const handle{ value ? ML_handle(uint32, value->get_handle()) : NULL };
+
+		if (m_cache.vbo == handle) { return; }
+
+		ML_glCheck(glBindBuffer(GL_ARRAY_BUFFER, m_cache.vbo = handle));
+	}
+
+	void opengl_render_context::bind_indexbuffer(indexbuffer const * value)
+	{
+		uint32 const handle{ value ? ML_handle(uint32, value->get_handle()) : NULL };
+
+		if (value) { m_cache.index_type = value->get_type(); }
+
+		if (m_cache.ibo == handle) { return; }
+
+		ML_glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_cache.ibo = handle));
+	}
+
+	void opengl_render_context::bind_uniformbuffer(uniformbuffer const * value, uint32 binding, size_t offset, size_t size)
+	{
+		if (value && !size) { size = value->get_size() - offset; }
+
+		bind_uniform_range(value ? ML_handle(uint32, value->get_handle()) : NULL, binding, offset, size);
+	}
+
+	void opengl_render_context::bind_streambuffer(streambuffer const * value, uint32 binding, size_t offset, size_t size)
+	{
+		bind_uniform_range(value ? ML_handle(uint32, value->get_handle()) : NULL, binding, offset, size);
+	}
+
+	void opengl_render_context::bind_uniform_range(uint32 handle, uint32 binding, size_t offset, size_t size)
+	{
+		if (binding < state_cache::max_uniform_bindings)
+		{
+			auto & e{ m_cache.uniforms[binding] };
+
+			if (e.handle == handle && e.offset == offset && e.size == size) { return; }
+
+			e = { handle, offset, size };
+		}
+
+		if (handle)
+		{
+			ML_glCheck(glBindBufferRange(GL_UNIFORM_BUFFER, binding, handle, (intptr_t)offset, (intptr_t)size));
+		}
+		else
+		{
+			ML_glCheck(glBindBufferBase(GL_UNIFORM_BUFFER, binding, NULL));
+		}
+	}
+
+	void opengl_render_context::bind_storagebuffer(storagebuffer const * value, uint32 binding, size_t offset, size_t size)
+	{
+		uint32 const handle{ value ? ML_handle(uint32, value->get_handle()) : NULL };
+
+		if (value && !size) { size = value->get_size() - offset; }
+
+		if (binding < state_cache::max_storage_bindings)
+		{
+			auto & e{ m_cache.storages[binding] };
+
+			if (e.handle == handle && e.offset == offset && e.size == size) { return; }
+
+			e = { handle, offset, size };
+		}
+
+		if (handle)
+		{
+			ML_glCheck(glBindBufferRange(GL_SHADER_STORAGE_BUFFER, binding, handle, (intptr_t)offset, (intptr_t)size));
+		}
+		else
+		{
+			ML_glCheck(glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, NULL));
+		}
+	}
+
+	void opengl_render_context::bind_texture(texture const * value, uint32 slot)
+	{
+		uint32 const handle{ value ? ML_handle(uint32, value->get_handle()) : NULL };
+
+		if (slot < state_cache::max_texture_slots)
+		{
+			if (m_cache.textures[slot] == handle) { return; }
+
+			m_cache.textures[slot] = handle;
+		}
+
+		ML_glCheck(glBindTextureUnit(slot, handle));
+
+		render_counters::add(_stats(get_device()).texture_binds);
+	}
+
+	void opengl_render_context::bind_image(texture const * value, uint32 unit, uint32 access, uint32 level)
+	{
+		if (!value)
+		{
+			ML_glCheck(glBindImageTexture(unit, NULL, 0, false, 0, GL_READ_ONLY, GL_RGBA8));
+			return;
+		}
+
+		// unsized formats are rejected by the driver
+		uint32 const format{ value->get_format().color };
+		if (!is_image_format(format))
+		{
+			return (void)debug::fail("bind_image needs a sized texture format");
+		}
+
+		// arrays, volumes, and cubes bind every layer
+		uint32 const type{ value->get_type() };
+
+		bool const layered{ type == texture_type_2d_array || type == texture_type_3d || type == texture_type_cube };
+
+		ML_glCheck(glBindImageTexture(
+			unit,
+			ML_handle(uint32, value->get_handle()),
+			(int32)level,
+			layered,
+			0,
+			_image_access<to_impl>(access),
+			_format<to_impl>(format)));
+	}
+
+	void opengl_render_context::bind_framebuffer(framebuffer const * value)
+	{
+		uint32 const handle{ value ? ML_handle(uint32, value->get_handle()) : NULL };
+
+		if (m_cache.fbo != handle)
+		{
+			ML_glCheck(glBindFramebuffer(GL_FRAMEBUFFER, m_cache.fbo = handle));
+
+			render_counters::add(_stats(get_device()).framebuffer_binds);
+		}
+
+		if (value)
+		{
+			set_viewport({ {}, value->get_size() });
+		}
+	}
+
+	void opengl_render_context::bind_program(program const * value)
+	{
+		if (value && !value->ready()) { value = m_fallback.get(); }
+
+		uint32 const handle{ value ? ML_handle(uint32, value->get_handle()) : NULL };
+
+		if (m_cache.pgm == handle) { return; }
+
+		ML_glCheck(ML_glUseProgram(m_cache.pgm = handle));
+
+		m_cache.pso = nullptr;
+
+		render_counters::add(_stats(get_device()).program_binds);
+	}
+
+	void opengl_render_context::set_fallback_program(ref<program> const & value)
+	{
+		ML_assert(!value || value->ready());
+
+		m_fallback = value;
+
+		m_cache.pgm = state_cache::unknown;
+	}
+
+	void opengl_render_context::bind_shader(shader const * value)
 	{
 		ML_glCheck(glBindProgramPipeline(m_handle));
 
@@ -523,50 +1289,90 @@ namespace ml::gfx
 		}
 	}
 
+	void opengl_render_context::bind_pipeline_state(pipeline_state const * value)
+	{
+		if (!value || m_cache.pso == value) { return; }
+
+		pipeline_state::spec_type const & desc{ value->get_spec() };
+		pipeline_hash const & h{ value->get_hash() };
+		pipeline_hash & c{ m_cache.pipeline };
+
+		// parts with matching hashes are already applied, the rest still diff by field
+		if (c.alpha != h.alpha) { set_alpha_state(desc.alpha); }
+		if (c.blend != h.blend) { set_blend_state(desc.blend); }
+		if (c.cull != h.cull) { set_cull_state(desc.cull); }
+		if (c.depth != h.depth) { set_depth_state(desc.depth); }
+		if (c.stencil != h.stencil) { set_stencil_state(desc.stencil); }
+
+		bind_program(desc.program.get());
+
+		// a fallback stands in for a compiling program, so bind again next time
+		c = h;
+		m_cache.pso = (!desc.program || desc.program->ready()) ? value : nullptr;
+	}
+
 	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 	void opengl_render_context::upload(uniform_id loc, bool value)
 	{
+		render_counters::add(_stats(get_device()).uniform_uploads);
+
 		ML_glCheck(ML_glUniform1i(ML_handle(int32, loc), (int32)value));
 	}
 
 	void opengl_render_context::upload(uniform_id loc, int32 value)
 	{
+		render_counters::add(_stats(get_device()).uniform_uploads);
+
 		ML_glCheck(ML_glUniform1i(ML_handle(int32, loc), value));
 	}
 
 	void opengl_render_context::upload(uniform_id loc, float32 value)
 	{
+		render_counters::add(_stats(get_device()).uniform_uploads);
+
 		ML_glCheck(ML_glUniform1f(ML_handle(int32, loc), value));
 	}
 
 	void opengl_render_context::upload(uniform_id loc, vec2f const & value)
 	{
+		render_counters::add(_stats(get_device()).uniform_uploads);
+
 		ML_glCheck(ML_glUniform2f(ML_handle(int32, loc), value[0], value[1]));
 	}
 
 	void opengl_render_context::upload(uniform_id loc, vec3f const & value)
 	{
+		render_counters::add(_stats(get_device()).uniform_uploads);
+
 		ML_glCheck(ML_glUniform3f(ML_handle(int32, loc), value[0], value[1], value[2]));
 	}
 
 	void opengl_render_context::upload(uniform_id loc, vec4f const & value)
 	{
+		render_counters::add(_stats(get_device()).uniform_uploads);
+
 		ML_glCheck(ML_glUniform4f(ML_handle(int32, loc), value[0], value[1], value[2], value[3]));
 	}
 
 	void opengl_render_context::upload(uniform_id loc, mat2f const & value)
 	{
+		render_counters::add(_stats(get_device()).uniform_uploads);
+
 		ML_glCheck(ML_glUniformMatrix2fv(ML_handle(int32, loc), 1, false, value));
 	}
 
 	void opengl_render_context::upload(uniform_id loc, mat3f const & value)
 	{
+		render_counters::add(_stats(get_device()).uniform_uploads);
+
 		ML_glCheck(ML_glUniformMatrix3fv(ML_handle(int32, loc), 1, false, value));
 	}
 
 	void opengl_render_context::upload(uniform_id loc, mat4f const & value)
 	{
+		render_counters::add(_stats(get_device()).uniform_uploads);
+
 		ML_glCheck(ML_glUniformMatrix4fv(ML_handle(int32, loc), 1, false, value));
 	}
 
@@ -584,75 +1390,60 @@ namespace ml::gfx
 		: vertexarray{ parent }
 		, m_mode{ desc.prim }
 	{
-		ML_glCheck(glGenVertexArrays(1, &m_handle));
-		ML_glCheck(glBindVertexArray(m_handle));
+		update_format();
 	}
 
 	opengl_vertexarray::~opengl_vertexarray()
 	{
-		ML_glCheck(glDeleteVertexArrays(1, &m_handle));
+		// the format object is shared and owned by the device
 	}
 
 	bool opengl_vertexarray::revalue()
 	{
-		if (m_handle) { ML_glCheck(glDeleteVertexArrays(1, &m_handle)); }
+		m_vertices.clear(); m_indices.reset(); m_instances.reset(); m_stream.reset();
 
-		m_vertices.clear(); m_indices.reset();
-		
-		ML_glCheck(glGenVertexArrays(1, &m_handle));
+		update_format();
 
 		return (bool)m_handle;
 	}
 
+	void opengl_vertexarray::update_format()
+	{
+		m_handle = static_cast<opengl_render_device *>(get_device())->get_vertex_format(
+			m_layout,
+			m_instances ? &m_instance_layout : nullptr,
+			m_stream ? &m_stream_layout : nullptr,
+			m_stream_location);
+	}
+
 	void opengl_vertexarray::add_vertices(ref<vertexbuffer> const & value)
 	{
-		if (!m_handle || !value) { return; }
-		
-		bind();
-		
-		m_vertices.emplace_back(value)->bind();
+		if (value) { m_vertices.emplace_back(value); }
+	}
 
-		for (size_t i = 0; i < m_layout.elements().size(); ++i)
-		{
-			auto const & e{ m_layout.elements()[i] };
+	void opengl_vertexarray::set_indices(ref<indexbuffer> const & value)
+	{
+		m_indices = value;
+	}
 
-			if (auto const type{ std::invoke([&]() noexcept -> uint32
-			{
-				switch (e.get_base_type())
-				{
-				default					: return 0			; // unknown
-				case hashof_v<bool>		: return GL_BOOL	; // bool
-				case hashof_v<int32>	: return GL_INT		; // int
-				case hashof_v<float32>	: return GL_FLOAT	; // float
-				}
-			}) }; type == GL_INT)
-			{
-				ML_glCheck(glVertexAttribIPointer(
-					(uint32)i,
-					e.get_component_count(),
-					type,
-					m_layout.stride(),
-					reinterpret_cast<addr_t>(e.offset)));
-			}
-			else
-			{
-				ML_glCheck(glVertexAttribPointer(
-					(uint32)i,
-					e.get_component_count(),
-					type,
-					e.normalized,
-					m_layout.stride(),
-					reinterpret_cast<addr_t>(e.offset)));
-			}
-			ML_glCheck(glEnableVertexAttribArray((uint32)i));
-		}
+	void opengl_vertexarray::set_instances(ref<vertexbuffer> const & value, buffer_layout const & layout)
+	{
+		m_instances = value;
+
+		m_instance_layout = layout;
+
+		update_format();
 	}
 
-	void opengl_vertexarray::set_indices(ref<indexbuffer> const & value)
+	void opengl_vertexarray::set_stream(ref<streambuffer> const & value, buffer_layout const & layout, uint32 first_location)
 	{
-		bind();
+		m_stream = value;
+
+		m_stream_layout = layout;
+
+		m_stream_location = first_location;
 
-		if (m_indices = value) { m_indices->bind(); }
+		update_format();
 	}
 
 	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
@@ -672,21 +1463,24 @@ namespace ml::gfx
 	{
 		ML_glCheck(glGenBuffers(1, &m_handle));
 		ML_glCheck(glBindBuffer(GL_ARRAY_BUFFER, m_handle));
+		_invalidate_bindings(get_device());
 		ML_glCheck(glBufferData(
 			GL_ARRAY_BUFFER,
 			(uint32)m_buffer.size(),
 			m_buffer.data(),
 			_usage<to_impl>(m_usage)));
+		if (desc.data) { render_counters::add(_stats(get_device()).bytes_uploaded, m_buffer.size()); }
 	}
 
 	opengl_vertexbuffer::~opengl_vertexbuffer()
 	{
 		ML_glCheck(glDeleteBuffers(1, &m_handle));
+		_invalidate_bindings(get_device());
 	}
 
 	bool opengl_vertexbuffer::revalue()
 	{
-		if (m_handle) { ML_glCheck(glDeleteBuffers(1, &m_handle)); }
+		if (m_handle) { ML_glCheck(glDeleteBuffers(1, &m_handle)); _invalidate_bindings(get_device()); }
 
 		m_buffer.clear();
 
@@ -697,12 +1491,18 @@ namespace ml::gfx
 
 	void opengl_vertexbuffer::set_data(size_t count, addr_t data, size_t offset)
 	{
-		m_buffer = bufcpy<float32>(count, data);
-		ML_glCheck(glBufferSubData(
-			GL_ARRAY_BUFFER,
-			offset,
-			(uint32)m_buffer.size(),
-			m_buffer.data()));
+		// offset is in bytes, writes must fit the existing store
+		size_t const size{ count * sizeof(float32) };
+		if (!data || m_buffer.size() < offset || m_buffer.size() - offset < size)
+		{
+			return (void)debug::fail("vertexbuffer write out of range");
+		}
+
+		std::memcpy(m_buffer.data() + offset, data, size);
+
+		ML_glCheck(glNamedBufferSubData(m_handle, (intptr_t)offset, (intptr_t)size, data));
+
+		render_counters::add(_stats(get_device()).bytes_uploaded, size);
 	}
 
 	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
@@ -718,25 +1518,31 @@ namespace ml::gfx
 	opengl_indexbuffer::opengl_indexbuffer(render_device * parent, spec_type const & desc, allocator_type alloc)
 		: indexbuffer	{ parent }
 		, m_usage		{ desc.usage }
-		, m_buffer		{ bufcpy<uint32>(desc.count, desc.data), alloc }
+		, m_type		{ desc.type }
+		, m_buffer		{ bufcpy(desc.count * get_type_size(desc.type), desc.data), alloc }
 	{
+		ML_assert("invalid index type" && (m_type == type_ushort || m_type == type_uint));
+
 		ML_glCheck(glGenBuffers(1, &m_handle));
 		ML_glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_handle));
+		_invalidate_bindings(get_device());
 		ML_glCheck(glBufferData(
 			GL_ELEMENT_ARRAY_BUFFER,
 			(uint32)m_buffer.size(),
 			m_buffer.data(),
 			_usage<to_impl>(m_usage)));
+		if (desc.data) { render_counters::add(_stats(get_device()).bytes_uploaded, m_buffer.size()); }
 	}
 
 	opengl_indexbuffer::~opengl_indexbuffer()
 	{
 		ML_glCheck(glDeleteBuffers(1, &m_handle));
+		_invalidate_bindings(get_device());
 	}
 
 	bool opengl_indexbuffer::revalue()
 	{
-		if (m_handle) { ML_glCheck(glDeleteBuffers(1, &m_handle)); }
+		if (m_handle) { ML_glCheck(glDeleteBuffers(1, &m_handle)); _invalidate_bindings(get_device()); }
 
 		m_buffer.clear();
 		
@@ -747,12 +1553,226 @@ namespace ml::gfx
 
 	void opengl_indexbuffer::set_data(size_t count, addr_t data, size_t offset)
 	{
-		m_buffer = bufcpy<uint32>(count, data);
-		ML_glCheck(glBufferSubData(
-			GL_ELEMENT_ARRAY_BUFFER,
-			offset,
-			(uint32)m_buffer.size(),
-			m_buffer.data()));
+		// offset is in bytes, count is in indices of the buffer's type
+		size_t const size{ count * get_type_size(m_type) };
+		if (!data || m_buffer.size() < offset || m_buffer.size() - offset < size)
+		{
+			return (void)debug::fail("indexbuffer write out of range");
+		}
+
+		std::memcpy(m_buffer.data() + offset, data, size);
+
+		ML_glCheck(glNamedBufferSubData(m_handle, (intptr_t)offset, (intptr_t)size, data));
+
+		render_counters::add(_stats(get_device()).bytes_uploaded, size);
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+// uniformbuffer
+namespace ml::gfx
+{
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	opengl_uniformbuffer::opengl_uniformbuffer(render_device * parent, spec_type const & desc, allocator_type alloc)
+		: uniformbuffer	{ parent }
+		, m_usage		{ desc.usage }
+		, m_size		{ desc.size }
+	{
+		// direct state access, nothing is bound
+		ML_glCheck(glCreateBuffers(1, &m_handle));
+		ML_glCheck(glNamedBufferData(m_handle, (intptr_t)m_size, desc.data, _usage<to_impl>(m_usage)));
+		if (desc.data) { render_counters::add(_stats(get_device()).bytes_uploaded, m_size); }
+	}
+
+	opengl_uniformbuffer::~opengl_uniformbuffer()
+	{
+		ML_glCheck(glDeleteBuffers(1, &m_handle));
+		_invalidate_bindings(get_device());
+	}
+
+	bool opengl_uniformbuffer::revalue()
+	{
+		if (m_handle) { ML_glCheck(glDeleteBuffers(1, &m_handle)); _invalidate_bindings(get_device()); }
+
+		ML_glCheck(glCreateBuffers(1, &m_handle));
+		ML_glCheck(glNamedBufferData(m_handle, (intptr_t)m_size, nullptr, _usage<to_impl>(m_usage)));
+
+		return (bool)m_handle;
+	}
+
+	void opengl_uniformbuffer::set_data(size_t size, addr_t data, size_t offset)
+	{
+		ML_assert(offset + size <= m_size);
+
+		ML_glCheck(glNamedBufferSubData(m_handle, (intptr_t)offset, (intptr_t)size, data));
+
+		render_counters::add(_stats(get_device()).bytes_uploaded, size);
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+// streambuffer
+namespace ml::gfx
+{
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	// regions start on a boundary that suits uniform ranges and instance attributes
+	static constexpr size_t _stream_align(size_t value) noexcept
+	{
+		return (value + 255) & ~(size_t)255;
+	}
+
+	opengl_streambuffer::opengl_streambuffer(render_device * parent, spec_type const & desc, allocator_type alloc)
+		: streambuffer	{ parent }
+		, m_region		{ _stream_align((std::max)(desc.size, (size_t)1)) }
+		, m_fences		{ (size_t)(std::max)(desc.frames, 1u), nullptr, alloc }
+	{
+		create_storage();
+	}
+
+	opengl_streambuffer::~opengl_streambuffer()
+	{
+		destroy_storage();
+	}
+
+	bool opengl_streambuffer::revalue()
+	{
+		destroy_storage();
+
+		create_storage();
+
+		return (bool)m_handle;
+	}
+
+	void opengl_streambuffer::create_storage()
+	{
+		uint32 const flags{ GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT };
+
+		size_t const size{ m_region * m_fences.size() };
+
+		ML_glCheck(glCreateBuffers(1, &m_handle));
+		ML_glCheck(glNamedBufferStorage(m_handle, (intptr_t)size, nullptr, flags));
+		ML_glCheck(m_data = (byte *)glMapNamedBufferRange(m_handle, 0, (intptr_t)size, flags));
+		ML_assert("failed mapping streambuffer" && m_data);
+
+		m_frame = m_head = 0;
+	}
+
+	void opengl_streambuffer::destroy_storage()
+	{
+		for (void *& e : m_fences)
+		{
+			if (e) { ML_glCheck(glDeleteSync((GLsync)e)); e = nullptr; }
+		}
+
+		if (m_handle)
+		{
+			ML_glCheck(glUnmapNamedBuffer(m_handle));
+			ML_glCheck(glDeleteBuffers(1, &m_handle));
+			_invalidate_bindings(get_device());
+			m_handle = NULL;
+		}
+
+		m_data = nullptr;
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	void opengl_streambuffer::next_frame()
+	{
+		// commands using the current region retire when this fence signals
+		if (m_fences[m_frame]) { ML_glCheck(glDeleteSync((GLsync)m_fences[m_frame])); }
+		ML_glCheck(m_fences[m_frame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+
+		m_frame = (m_frame + 1) % m_fences.size();
+		m_head = 0;
+
+		// block until the gpu is done reading the region we are about to write
+		if (GLsync const sync{ (GLsync)m_fences[m_frame] })
+		{
+			for (uint32 flags = GL_SYNC_FLUSH_COMMANDS_BIT;; flags = 0)
+			{
+				uint32 result;
+				ML_glCheck(result = glClientWaitSync(sync, flags, 1'000'000));
+				if (result != GL_TIMEOUT_EXPIRED) { break; }
+			}
+			ML_glCheck(glDeleteSync(sync));
+			m_fences[m_frame] = nullptr;
+		}
+	}
+
+	stream_range opengl_streambuffer::allocate(size_t size, size_t alignment)
+	{
+		if (!alignment) { alignment = 1; }
+
+		size_t const first{ (m_head + alignment - 1) / alignment * alignment };
+
+		if (!m_data || m_region < first + size) { return { nullptr, 0, 0 }; }
+
+		m_head = first + size;
+
+		size_t const offset{ m_frame * m_region + first };
+
+		return { m_data + offset, offset, size };
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+// storagebuffer
+namespace ml::gfx
+{
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	opengl_storagebuffer::opengl_storagebuffer(render_device * parent, spec_type const & desc, allocator_type alloc)
+		: storagebuffer	{ parent }
+		, m_usage		{ desc.usage }
+		, m_size		{ desc.size }
+	{
+		ML_glCheck(glCreateBuffers(1, &m_handle));
+		ML_glCheck(glNamedBufferData(m_handle, (intptr_t)m_size, desc.data, _usage<to_impl>(m_usage)));
+		if (desc.data) { render_counters::add(_stats(get_device()).bytes_uploaded, m_size); }
+	}
+
+	opengl_storagebuffer::~opengl_storagebuffer()
+	{
+		ML_glCheck(glDeleteBuffers(1, &m_handle));
+		_invalidate_bindings(get_device());
+	}
+
+	bool opengl_storagebuffer::revalue()
+	{
+		if (m_handle) { ML_glCheck(glDeleteBuffers(1, &m_handle)); _invalidate_bindings(get_device()); }
+
+		ML_glCheck(glCreateBuffers(1, &m_handle));
+		ML_glCheck(glNamedBufferData(m_handle, (intptr_t)m_size, nullptr, _usage<to_impl>(m_usage)));
+
+		return (bool)m_handle;
+	}
+
+	void opengl_storagebuffer::set_data(size_t size, addr_t data, size_t offset)
+	{
+		ML_assert(offset + size <= m_size);
+
+		ML_glCheck(glNamedBufferSubData(m_handle, (intptr_t)offset, (intptr_t)size, data));
+
+		render_counters::add(_stats(get_device()).bytes_uploaded, size);
+	}
+
+	void opengl_storagebuffer::get_data(size_t size, void * data, size_t offset) const
+	{
+		ML_assert(offset + size <= m_size);
+
+		ML_glCheck(glGetNamedBufferSubData(m_handle, (intptr_t)offset, (intptr_t)size, data));
 	}
 
 	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
@@ -773,6 +1793,7 @@ namespace ml::gfx
 	{
 		ML_glCheck(glGenTextures(1, &m_handle));
 		ML_glCheck(glBindTexture(GL_TEXTURE_2D, m_handle));
+		_invalidate_bindings(get_device());
 		ML_glCheck(glTexImage2D(
 			GL_TEXTURE_2D,
 			0,
@@ -780,9 +1801,10 @@ namespace ml::gfx
 			m_size[0],
 			m_size[1],
 			0,
-			_format<to_impl>(m_format.pixel),
+			_format<to_impl>(get_base_format(m_format.pixel)),
 			_type<to_impl>(m_format.type),
 			desc.data));
+		if (desc.data) { render_counters::add(_stats(get_device()).bytes_uploaded, _image_size(m_format, m_size)); }
 		set_repeated(m_flags & texture_flags_repeat);
 		set_smooth(m_flags & texture_flags_smooth);
 		set_mipmapped(m_flags & texture_flags_mipmap);
@@ -790,14 +1812,18 @@ namespace ml::gfx
 
 	opengl_texture2d::~opengl_texture2d()
 	{
+		_release_bindless(m_bindless);
 		ML_glCheck(glDeleteTextures(1, &m_handle));
+		_invalidate_bindings(get_device());
 	}
 
 	bool opengl_texture2d::revalue()
 	{
 		if (!m_locked) { return debug::fail("texture2d is not locked"); }
 
-		if (m_handle) { ML_glCheck(glDeleteTextures(1, &m_handle)); }
+		_release_bindless(m_bindless);
+
+		if (m_handle) { ML_glCheck(glDeleteTextures(1, &m_handle)); _invalidate_bindings(get_device()); }
 		
 		ML_glCheck(glGenTextures(1, &m_handle));
 
@@ -818,6 +1844,11 @@ namespace ml::gfx
 		debug::warn("texture lock/unlock NYI");
 	}
 
+	uint64 opengl_texture2d::get_bindless_handle()
+	{
+		return _bindless_handle(get_device(), m_handle, m_bindless);
+	}
+
 	void opengl_texture2d::update(vec2i const & size, addr_t data)
 	{
 		if (!m_locked) { return (void)debug::fail("texture2d is not locked"); }
@@ -834,9 +1865,11 @@ namespace ml::gfx
 			m_size[0],
 			m_size[1],
 			0,
-			_format<to_impl>(m_format.pixel),
+			_format<to_impl>(get_base_format(m_format.pixel)),
 			_type<to_impl>(m_format.type),
 			data));
+
+		if (data) { render_counters::add(_stats(get_device()).bytes_uploaded, _image_size(m_format, m_size)); }
 		
 		set_repeated(m_flags & texture_flags_repeat);
 		set_smooth(m_flags & texture_flags_smooth);
@@ -859,90 +1892,253 @@ namespace ml::gfx
 			pos[1],
 			m_size[0],
 			m_size[1],
+			_format<to_impl>(get_base_format(m_format.color)),
+			_type<to_impl>(m_format.type),
+			data));
+
+		if (data) { render_counters::add(_stats(get_device()).bytes_uploaded, _image_size(m_format, m_size)); }
+		
+		set_repeated(m_flags & texture_flags_repeat);
+		set_smooth(m_flags & texture_flags_smooth);
+		set_mipmapped(m_flags & texture_flags_mipmap);
+	}
+
+	void opengl_texture2d::set_mipmapped(bool value)
+	{
+		if (!m_locked) { return (void)debug::fail("texture2d is not locked"); }
+
+		// sampler state is frozen once a handle exists
+		if (m_bindless) { return (void)debug::fail("texture2d has a bindless handle"); }
+
+		ML_flag_write(m_flags, texture_flags_mipmap, value);
+
+		bool const smooth{ ML_flag_read(m_flags, texture_flags_smooth) };
+
+		if (smooth) { ML_glCheck(glGenerateMipmap(GL_TEXTURE_2D)); }
+
+		ML_glCheck(glTexParameteri(GL_TEXTURE_2D,
+			GL_TEXTURE_MAG_FILTER,
+			value
+			? smooth ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR
+			: smooth ? GL_LINEAR : GL_NEAREST));
+	}
+
+	void opengl_texture2d::set_repeated(bool value)
+	{
+		if (!m_locked) { return (void)debug::fail("texture2d is not locked"); }
+
+		if (m_bindless) { return (void)debug::fail("texture2d has a bindless handle"); }
+
+		ML_flag_write(m_flags, texture_flags_repeat, value);
+
+		static bool const edge_clamp_available
+		{
+			get_device()->get_info().texture_edge_clamp_available
+		};
+
+		ML_glCheck(glTexParameteri(GL_TEXTURE_2D,
+			GL_TEXTURE_WRAP_S,
+			value
+			? GL_REPEAT
+			: edge_clamp_available ? GL_CLAMP_TO_EDGE : GL_CLAMP));
+
+		ML_glCheck(glTexParameteri(GL_TEXTURE_2D,
+			GL_TEXTURE_WRAP_T,
+			value
+			? GL_REPEAT
+			: edge_clamp_available ? GL_CLAMP_TO_EDGE : GL_CLAMP));
+	}
+
+	void opengl_texture2d::set_smooth(bool value)
+	{
+		if (!m_locked) { return (void)debug::fail("texture2d is not locked"); }
+
+		if (m_bindless) { return (void)debug::fail("texture2d has a bindless handle"); }
+
+		ML_flag_write(m_flags, texture_flags_smooth, value);
+
+		ML_glCheck(glTexParameteri(GL_TEXTURE_2D,
+			GL_TEXTURE_MAG_FILTER,
+			value ? GL_LINEAR : GL_NEAREST));
+
+		ML_glCheck(glTexParameteri(GL_TEXTURE_2D,
+			GL_TEXTURE_MIN_FILTER,
+			ML_flag_read(m_flags, texture_flags_mipmap)
+			? value ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR
+			: value ? GL_LINEAR : GL_NEAREST));
+	}
+
+	bitmap opengl_texture2d::copy_to_image() const
+	{
+		if (!m_locked) { debug::fail("texture2d is not locked"); return bitmap{}; }
+
+		bitmap temp{ m_size, calc_bits_per_pixel(get_base_format(m_format.color)) };
+		if (m_handle)
+		{
+			bind();
+
+			ML_glCheck(glGetTexImage(GL_TEXTURE_2D, 0,
+				_format<to_impl>(get_base_format(m_format.color)),
+				_type<to_impl>(m_format.type),
+				temp.data()));
+
+			unbind();
+		}
+		return temp;
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+// texture2d array
+namespace ml::gfx
+{
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	opengl_texture2d_array::opengl_texture2d_array(render_device * parent, spec_type const & desc, allocator_type alloc)
+		: texture2d_array	{ parent }
+		, m_size			{ desc.size }
+		, m_layers			{ (std::max)(desc.layers, 1u) }
+		, m_format			{ desc.format }
+		, m_flags			{ desc.flags }
+	{
+		ML_assert(m_layers <= parent->get_info().max_array_texture_layers);
+
+		ML_glCheck(glGenTextures(1, &m_handle));
+		ML_glCheck(glBindTexture(GL_TEXTURE_2D_ARRAY, m_handle));
+		_invalidate_bindings(get_device());
+		ML_glCheck(glTexImage3D(
+			GL_TEXTURE_2D_ARRAY,
+			0,
 			_format<to_impl>(m_format.color),
+			m_size[0],
+			m_size[1],
+			(int32)m_layers,
+			0,
+			_format<to_impl>(get_base_format(m_format.pixel)),
+			_type<to_impl>(m_format.type),
+			desc.data));
+		if (desc.data) { render_counters::add(_stats(get_device()).bytes_uploaded, _image_size(m_format, m_size) * m_layers); }
+		set_repeated(m_flags & texture_flags_repeat);
+		set_smooth(m_flags & texture_flags_smooth);
+		set_mipmapped(m_flags & texture_flags_mipmap);
+	}
+
+	opengl_texture2d_array::~opengl_texture2d_array()
+	{
+		_release_bindless(m_bindless);
+		ML_glCheck(glDeleteTextures(1, &m_handle));
+		_invalidate_bindings(get_device());
+	}
+
+	bool opengl_texture2d_array::revalue()
+	{
+		if (!m_locked) { return debug::fail("texture2d_array is not locked"); }
+
+		_release_bindless(m_bindless);
+
+		if (m_handle) { ML_glCheck(glDeleteTextures(1, &m_handle)); _invalidate_bindings(get_device()); }
+
+		ML_glCheck(glGenTextures(1, &m_handle));
+
+		return (bool)m_handle;
+	}
+
+	void opengl_texture2d_array::lock()
+	{
+		m_locked = true;
+
+		debug::warn("texture lock/unlock NYI");
+	}
+
+	void opengl_texture2d_array::unlock()
+	{
+		m_locked = false;
+
+		debug::warn("texture lock/unlock NYI");
+	}
+
+	void opengl_texture2d_array::update(uint32 layer, addr_t data)
+	{
+		if (!m_locked) { return (void)debug::fail("texture2d_array is not locked"); }
+
+		if (!m_handle || !data || m_layers <= layer) { return; }
+
+		ML_glCheck(glTextureSubImage3D(
+			m_handle,
+			0,
+			0, 0, (int32)layer,
+			m_size[0], m_size[1], 1,
+			_format<to_impl>(get_base_format(m_format.pixel)),
 			_type<to_impl>(m_format.type),
 			data));
-		
-		set_repeated(m_flags & texture_flags_repeat);
-		set_smooth(m_flags & texture_flags_smooth);
-		set_mipmapped(m_flags & texture_flags_mipmap);
+
+		render_counters::add(_stats(get_device()).bytes_uploaded, _image_size(m_format, m_size));
+
+		if (ML_flag_read(m_flags, texture_flags_mipmap))
+		{
+			ML_glCheck(glGenerateTextureMipmap(m_handle));
+		}
 	}
 
-	void opengl_texture2d::set_mipmapped(bool value)
+	void opengl_texture2d_array::set_mipmapped(bool value)
 	{
-		if (!m_locked) { return (void)debug::fail("texture2d is not locked"); }
+		if (!m_locked) { return (void)debug::fail("texture2d_array is not locked"); }
+
+		if (m_bindless) { return (void)debug::fail("texture2d_array has a bindless handle"); }
 
 		ML_flag_write(m_flags, texture_flags_mipmap, value);
 
 		bool const smooth{ ML_flag_read(m_flags, texture_flags_smooth) };
 
-		if (smooth) { ML_glCheck(glGenerateMipmap(GL_TEXTURE_2D)); }
+		if (value) { ML_glCheck(glGenerateTextureMipmap(m_handle)); }
 
-		ML_glCheck(glTexParameteri(GL_TEXTURE_2D,
-			GL_TEXTURE_MAG_FILTER,
+		ML_glCheck(glTextureParameteri(m_handle,
+			GL_TEXTURE_MIN_FILTER,
 			value
 			? smooth ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR
 			: smooth ? GL_LINEAR : GL_NEAREST));
 	}
 
-	void opengl_texture2d::set_repeated(bool value)
+	void opengl_texture2d_array::set_repeated(bool value)
 	{
-		if (!m_locked) { return (void)debug::fail("texture2d is not locked"); }
+		if (!m_locked) { return (void)debug::fail("texture2d_array is not locked"); }
+
+		if (m_bindless) { return (void)debug::fail("texture2d_array has a bindless handle"); }
 
 		ML_flag_write(m_flags, texture_flags_repeat, value);
 
-		static bool const edge_clamp_available
-		{
-			get_device()->get_info().texture_edge_clamp_available
-		};
+		uint32 const wrap{ value ? (uint32)GL_REPEAT : (uint32)GL_CLAMP_TO_EDGE };
 
-		ML_glCheck(glTexParameteri(GL_TEXTURE_2D,
-			GL_TEXTURE_WRAP_S,
-			value
-			? GL_REPEAT
-			: edge_clamp_available ? GL_CLAMP_TO_EDGE : GL_CLAMP));
+		ML_glCheck(glTextureParameteri(m_handle, GL_TEXTURE_WRAP_S, wrap));
 
-		ML_glCheck(glTexParameteri(GL_TEXTURE_2D,
-			GL_TEXTURE_WRAP_T,
-			value
-			? GL_REPEAT
-			: edge_clamp_available ? GL_CLAMP_TO_EDGE : GL_CLAMP));
+		ML_glCheck(glTextureParameteri(m_handle, GL_TEXTURE_WRAP_T, wrap));
 	}
 
-	void opengl_texture2d::set_smooth(bool value)
+	void opengl_texture2d_array::set_smooth(bool value)
 	{
-		if (!m_locked) { return (void)debug::fail("texture2d is not locked"); }
+		if (!m_locked) { return (void)debug::fail("texture2d_array is not locked"); }
+
+		if (m_bindless) { return (void)debug::fail("texture2d_array has a bindless handle"); }
 
 		ML_flag_write(m_flags, texture_flags_smooth, value);
 
-		ML_glCheck(glTexParameteri(GL_TEXTURE_2D,
+		ML_glCheck(glTextureParameteri(m_handle,
 			GL_TEXTURE_MAG_FILTER,
 			value ? GL_LINEAR : GL_NEAREST));
 
-		ML_glCheck(glTexParameteri(GL_TEXTURE_2D,
+		ML_glCheck(glTextureParameteri(m_handle,
 			GL_TEXTURE_MIN_FILTER,
 			ML_flag_read(m_flags, texture_flags_mipmap)
 			? value ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR
 			: value ? GL_LINEAR : GL_NEAREST));
 	}
 
-	bitmap opengl_texture2d::copy_to_image() const
+	uint64 opengl_texture2d_array::get_bindless_handle()
 	{
-		if (!m_locked) { debug::fail("texture2d is not locked"); return bitmap{}; }
-
-		bitmap temp{ m_size, calc_bits_per_pixel(m_format.color) };
-		if (m_handle)
-		{
-			bind();
-
-			ML_glCheck(glGetTexImage(GL_TEXTURE_2D, 0,
-				_format<to_impl>(m_format.color),
-				_type<to_impl>(m_format.type),
-				temp.data()));
-
-			unbind();
-		}
-		return temp;
+		return _bindless_handle(get_device(), m_handle, m_bindless);
 	}
 
 	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
@@ -966,14 +2162,18 @@ namespace ml::gfx
 
 	opengl_texture3d::~opengl_texture3d()
 	{
+		_release_bindless(m_bindless);
 		ML_glCheck(glDeleteTextures(1, &m_handle));
+		_invalidate_bindings(get_device());
 	}
 
 	bool opengl_texture3d::revalue()
 	{
 		if (!m_locked) { return debug::fail("texture3d is not locked"); }
 
-		if (m_handle) { ML_glCheck(glDeleteTextures(1, &m_handle)); }
+		_release_bindless(m_bindless);
+
+		if (m_handle) { ML_glCheck(glDeleteTextures(1, &m_handle)); _invalidate_bindings(get_device()); }
 		
 		ML_glCheck(glGenTextures(1, &m_handle));
 		
@@ -994,6 +2194,11 @@ namespace ml::gfx
 		debug::warn("texture lock/unlock NYI");
 	}
 
+	uint64 opengl_texture3d::get_bindless_handle()
+	{
+		return _bindless_handle(get_device(), m_handle, m_bindless);
+	}
+
 	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 }
 
@@ -1015,14 +2220,18 @@ namespace ml::gfx
 
 	opengl_texturecube::~opengl_texturecube()
 	{
+		_release_bindless(m_bindless);
 		ML_glCheck(glDeleteTextures(1, &m_handle));
+		_invalidate_bindings(get_device());
 	}
 
 	bool opengl_texturecube::revalue()
 	{
 		if (!m_locked) { return debug::fail("texturecube is not locked"); }
 
-		if (m_handle) { ML_glCheck(glDeleteTextures(1, &m_handle)); }
+		_release_bindless(m_bindless);
+
+		if (m_handle) { ML_glCheck(glDeleteTextures(1, &m_handle)); _invalidate_bindings(get_device()); }
 		
 		ML_glCheck(glGenTextures(1, &m_handle));
 		
@@ -1043,6 +2252,11 @@ namespace ml::gfx
 		debug::warn("texture lock/unlock NYI");
 	}
 
+	uint64 opengl_texturecube::get_bindless_handle()
+	{
+		return _bindless_handle(get_device(), m_handle, m_bindless);
+	}
+
 	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 }
 
@@ -1065,11 +2279,12 @@ namespace ml::gfx
 	opengl_framebuffer::~opengl_framebuffer()
 	{
 		ML_glCheck(glDeleteFramebuffers(1, &m_handle));
+		_invalidate_bindings(get_device());
 	}
 
 	bool opengl_framebuffer::revalue()
 	{
-		if (m_handle) { ML_glCheck(glDeleteFramebuffers(1, &m_handle)); }
+		if (m_handle) { ML_glCheck(glDeleteFramebuffers(1, &m_handle)); _invalidate_bindings(get_device()); }
 		
 		ML_glCheck(glGenFramebuffers(1, &m_handle));
 		
@@ -1172,33 +2387,6 @@ namespace ml::gfx
 {
 	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
-	opengl_program::program_uniform_binder::program_uniform_binder(opengl_program & p, cstring name) noexcept
-	{
-		if (!name || !*name || !(self = p.m_handle)) { return; }
-		
-		ML_glCheck(last = ML_glGetProgram());
-
-		if (self != last) { ML_glCheck(ML_glUseProgram(self)); }
-
-		location = p.m_uniforms.find_or_add_fn(hashof(name, std::strlen(name)), [&
-		]() noexcept
-		{
-			int32 temp{};
-			ML_glCheck(temp = ML_glGetUniformLocation(self, name));
-			return ML_handle(uniform_id, temp);
-		});
-	}
-
-	opengl_program::program_uniform_binder::~program_uniform_binder() noexcept
-	{
-		if (self && (self != last))
-		{
-			ML_glCheck(glUseProgramObjectARB(last));
-		}
-	}
-
-	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
-
 	opengl_program::opengl_program(render_device * parent, spec_type const & desc, allocator_type alloc)
 		: program{ parent }
 	{
@@ -1208,13 +2396,17 @@ namespace ml::gfx
 	opengl_program::~opengl_program()
 	{
 		ML_glCheck(ML_glDeleteProgram(m_handle));
+		_invalidate_bindings(get_device());
 	}
 
 	bool opengl_program::revalue()
 	{
-		if (m_handle) { ML_glCheck(ML_glDeleteProgram(m_handle)); }
+		m_status = program_status_none;
+
+		if (m_handle) { ML_glCheck(ML_glDeleteProgram(m_handle)); _invalidate_bindings(get_device()); }
 
 		m_uniforms.clear();
+		m_blocks.clear();
 		m_textures.clear();
 		for (auto & e : m_shaders) { e = NULL; }
 		
@@ -1272,6 +2464,12 @@ namespace ml::gfx
 
 	bool opengl_program::link()
 	{
+		// keep the binary around for the program cache
+		if (get_device()->get_info().program_binaries_available)
+		{
+			ML_glCheck(glProgramParameteri(m_handle, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+		}
+
 		// link
 		ML_glCheck(ML_glLinkProgram(m_handle));
 
@@ -1281,19 +2479,305 @@ namespace ml::gfx
 		if (!success)
 		{
 			gl_get_program_info_log(m_handle, m_error_log);
+
+			m_status = program_status_failed;
+		}
+		else
+		{
+			reflect_uniforms();
+
+			reflect_uniform_blocks();
+
+			m_status = program_status_ready;
+		}
+		return success;
+	}
+
+	void opengl_program::attach_async(uint32 type, size_t count, cstring * str, int32 const * len)
+	{
+		if (!count || !str || !*str) { return; }
+
+		// compile status is not queried here, that would wait for the compiler
+		uint32 temp{};
+		ML_glCheck(temp = ML_glCreateShader(_shader_type<to_impl>(type)));
+		ML_glCheck(ML_glShaderSource(temp, (uint32)count, str, len));
+		ML_glCheck(ML_glCompileShader(temp));
+		ML_glCheck(ML_glAttachShader(m_handle, temp));
+		m_shaders[type] = ML_handle(object_id, temp);
+		m_source[type] = { str, str + count };
+	}
+
+	void opengl_program::link_async()
+	{
+		if (get_device()->get_info().program_binaries_available)
+		{
+			ML_glCheck(glProgramParameteri(m_handle, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+		}
+
+		ML_glCheck(ML_glLinkProgram(m_handle));
+
+		m_status = program_status_compiling;
+	}
+
+	uint32 opengl_program::poll()
+	{
+		if (uint32 const status{ get_status() }; status != program_status_compiling) { return status; }
+
+		// without the extension the status query below waits for the link
+		if (get_device()->get_info().parallel_shader_compile_available)
+		{
+			int32 done{};
+			ML_glCheck(glGetProgramiv(m_handle, GL_COMPLETION_STATUS_KHR, &done));
+			if (!done) { return program_status_compiling; }
+		}
+
+		int32 success{};
+		ML_glCheck(ML_glGetProgramLinkStatus(m_handle, &success));
+		if (!success)
+		{
+			gl_get_program_info_log(m_handle, m_error_log);
+
+			debug::warn(m_error_log);
+
+			m_status.store(program_status_failed, std::memory_order_release);
+
+			return program_status_failed;
+		}
+
+		reflect_uniforms();
+
+		reflect_uniform_blocks();
+
+		// the reflection above is visible to any thread that sees ready
+		m_status.store(program_status_ready, std::memory_order_release);
+
+		return program_status_ready;
+	}
+
+	bool opengl_program::get_binary(uint32 & format, list<byte> & data) const
+	{
+		if (!get_device()->get_info().program_binaries_available) { return false; }
+
+		int32 length{};
+		ML_glCheck(glGetProgramiv(m_handle, GL_PROGRAM_BINARY_LENGTH, &length));
+		if (length <= 0) { return false; }
+
+		data.resize((size_t)length);
+		ML_glCheck(glGetProgramBinary(m_handle, length, &length, &format, data.data()));
+		data.resize((size_t)length);
+		return !data.empty();
+	}
+
+	bool opengl_program::load_binary(uint32 format, addr_t data, size_t size)
+	{
+		if (!data || !size || !get_device()->get_info().program_binaries_available) { return false; }
+
+		ML_glCheck(glProgramBinary(m_handle, format, data, (int32)size));
+
+		// rejected after a driver update, the caller compiles from source instead
+		int32 success{};
+		ML_glCheck(glGetProgramiv(m_handle, GL_LINK_STATUS, &success));
+		if (!success)
+		{
+			revalue();
+		}
+		else
+		{
+			reflect_uniforms();
+
+			reflect_uniform_blocks();
+
+			m_status = program_status_ready;
 		}
 		return success;
 	}
 
+	void opengl_program::reflect_uniforms()
+	{
+		m_uniforms.clear();
+
+		int32 count{}, max_length{};
+		ML_glCheck(glGetProgramiv(m_handle, GL_ACTIVE_UNIFORMS, &count));
+		ML_glCheck(glGetProgramiv(m_handle, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_length));
+		if (count <= 0 || max_length <= 0) { return; }
+
+		string name((size_t)max_length, '\0');
+		for (int32 i = 0; i < count; ++i)
+		{
+			int32 length{}, size{}; uint32 type{};
+			ML_glCheck(ML_glGetActiveUniform(m_handle, (uint32)i, max_length, &length, &size, &type, name.data()));
+
+			// block members have no location
+			int32 loc{};
+			ML_glCheck(loc = ML_glGetUniformLocation(m_handle, name.data()));
+			if (loc < 0) { continue; }
+
+			m_uniforms.insert(hashof(name.data(), (size_t)length), ML_handle(uniform_id, loc));
+
+			// arrays are reported as name[0], also answer to the bare name
+			if (3 < length && !std::strncmp(name.data() + length - 3, "[0]", 3))
+			{
+				m_uniforms.insert(hashof(name.data(), (size_t)length - 3), ML_handle(uniform_id, loc));
+			}
+		}
+	}
+
+	void opengl_program::reflect_uniform_blocks()
+	{
+		m_blocks.clear();
+
+		int32 count{}, max_length{};
+		ML_glCheck(glGetProgramiv(m_handle, GL_ACTIVE_UNIFORM_BLOCKS, &count));
+		ML_glCheck(glGetProgramiv(m_handle, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &max_length));
+		if (count <= 0 || max_length <= 0) { return; }
+
+		int32 max_member_length{};
+		ML_glCheck(glGetProgramiv(m_handle, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_member_length));
+
+		string name((size_t)(std::max)(max_length, max_member_length), '\0');
+		list<int32> indices{}, offsets{}, sizes{}, array_strides{}, matrix_strides{}, types{};
+		for (uint32 i = 0; i < (uint32)count; ++i)
+		{
+			int32 length{}, size{}, binding{}, member_count{};
+			ML_glCheck(glGetActiveUniformBlockName(m_handle, i, max_length, &length, name.data()));
+			ML_glCheck(glGetActiveUniformBlockiv(m_handle, i, GL_UNIFORM_BLOCK_DATA_SIZE, &size));
+			ML_glCheck(glGetActiveUniformBlockiv(m_handle, i, GL_UNIFORM_BLOCK_BINDING, &binding));
+			ML_glCheck(glGetActiveUniformBlockiv(m_handle, i, GL_UNIFORM_BLOCK_ACTIVE_UNIFORMS, &member_count));
+
+			uniform_block & block{ m_blocks[hashof(name.data(), (size_t)length)] };
+			block.index = i;
+			block.binding = (uint32)binding;
+			block.size = (uint32)size;
+			if (member_count <= 0) { continue; }
+
+			indices.resize((size_t)member_count);
+			offsets.resize((size_t)member_count);
+			sizes.resize((size_t)member_count);
+			array_strides.resize((size_t)member_count);
+			matrix_strides.resize((size_t)member_count);
+			types.resize((size_t)member_count);
+
+			ML_glCheck(glGetActiveUniformBlockiv(m_handle, i, GL_UNIFORM_BLOCK_ACTIVE_UNIFORM_INDICES, indices.data()));
+			ML_glCheck(glGetActiveUniformsiv(m_handle, member_count, (uint32 const *)indices.data(), GL_UNIFORM_OFFSET, offsets.data()));
+			ML_glCheck(glGetActiveUniformsiv(m_handle, member_count, (uint32 const *)indices.data(), GL_UNIFORM_SIZE, sizes.data()));
+			ML_glCheck(glGetActiveUniformsiv(m_handle, member_count, (uint32 const *)indices.data(), GL_UNIFORM_ARRAY_STRIDE, array_strides.data()));
+			ML_glCheck(glGetActiveUniformsiv(m_handle, member_count, (uint32 const *)indices.data(), GL_UNIFORM_MATRIX_STRIDE, matrix_strides.data()));
+			ML_glCheck(glGetActiveUniformsiv(m_handle, member_count, (uint32 const *)indices.data(), GL_UNIFORM_TYPE, types.data()));
+
+			for (size_t j = 0; j < (size_t)member_count; ++j)
+			{
+				int32 member_length{};
+				ML_glCheck(glGetActiveUniformName(m_handle, (uint32)indices[j], (int32)name.size(), &member_length, name.data()));
+
+				uniform_block_member const member{
+					(uint32)offsets[j],
+					(uint32)sizes[j],
+					(uint32)array_strides[j],
+					(uint32)matrix_strides[j],
+					_uniform_type_size((uint32)types[j])
+				};
+
+				// drop the instance name and the array suffix
+				cstring first{ name.data() }, last{ name.data() + member_length };
+				if (cstring const dot{ std::strrchr(first, '.') }) { first = dot + 1; }
+				if (3 < (last - first) && !std::strncmp(last - 3, "[0]", 3)) { last -= 3; }
+
+				block.members.insert(hashof(first, (size_t)(last - first)), member);
+			}
+		}
+	}
+
+	bool opengl_program::bind_uniform_block(cstring name, uint32 binding)
+	{
+		if (!name || !*name) { return false; }
+
+		if (auto const it{ m_blocks.find(hashof(name, std::strlen(name))) })
+		{
+			uniform_block & block{ *it->second };
+
+			ML_glCheck(glUniformBlockBinding(m_handle, block.index, binding));
+
+			block.binding = binding;
+
+			return true;
+		}
+		return false;
+	}
+
 	uniform_id opengl_program::get_uniform_location(cstring name) noexcept
 	{
-		return m_uniforms.find_or_add_fn(hashof(name, std::strlen(name)), [&
-		]() noexcept
+		if (!name || !*name) { return ML_handle(uniform_id, -1); }
+
+		if (auto const it{ m_uniforms.find(hashof(name, std::strlen(name))) })
 		{
-			int32 temp{};
-			ML_glCheck(temp = ML_glGetUniformLocation(m_handle, name));
-			return ML_handle(uniform_id, temp);
-		});
+			return (*it->second);
+		}
+		return ML_handle(uniform_id, -1);
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	void opengl_program::upload(uniform_id loc, bool value)
+	{
+		render_counters::add(_stats(get_device()).uniform_uploads);
+
+		ML_glCheck(ML_glProgramUniform1i(m_handle, ML_handle(int32, loc), (int32)value));
+	}
+
+	void opengl_program::upload(uniform_id loc, int32 value)
+	{
+		render_counters::add(_stats(get_device()).uniform_uploads);
+
+		ML_glCheck(ML_glProgramUniform1i(m_handle, ML_handle(int32, loc), value));
+	}
+
+	void opengl_program::upload(uniform_id loc, float32 value)
+	{
+		render_counters::add(_stats(get_device()).uniform_uploads);
+
+		ML_glCheck(ML_glProgramUniform1f(m_handle, ML_handle(int32, loc), value));
+	}
+
+	void opengl_program::upload(uniform_id loc, vec2f const & value)
+	{
+		render_counters::add(_stats(get_device()).uniform_uploads);
+
+		ML_glCheck(ML_glProgramUniform2f(m_handle, ML_handle(int32, loc), value[0], value[1]));
+	}
+
+	void opengl_program::upload(uniform_id loc, vec3f const & value)
+	{
+		render_counters::add(_stats(get_device()).uniform_uploads);
+
+		ML_glCheck(ML_glProgramUniform3f(m_handle, ML_handle(int32, loc), value[0], value[1], value[2]));
+	}
+
+	void opengl_program::upload(uniform_id loc, vec4f const & value)
+	{
+		render_counters::add(_stats(get_device()).uniform_uploads);
+
+		ML_glCheck(ML_glProgramUniform4f(m_handle, ML_handle(int32, loc), value[0], value[1], value[2], value[3]));
+	}
+
+	void opengl_program::upload(uniform_id loc, mat2f const & value)
+	{
+		render_counters::add(_stats(get_device()).uniform_uploads);
+
+		ML_glCheck(ML_glProgramUniformMatrix2fv(m_handle, ML_handle(int32, loc), 1, false, value));
+	}
+
+	void opengl_program::upload(uniform_id loc, mat3f const & value)
+	{
+		render_counters::add(_stats(get_device()).uniform_uploads);
+
+		ML_glCheck(ML_glProgramUniformMatrix3fv(m_handle, ML_handle(int32, loc), 1, false, value));
+	}
+
+	void opengl_program::upload(uniform_id loc, mat4f const & value)
+	{
+		render_counters::add(_stats(get_device()).uniform_uploads);
+
+		ML_glCheck(ML_glProgramUniformMatrix4fv(m_handle, ML_handle(int32, loc), 1, false, value));
 	}
 
 	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
@@ -1339,6 +2823,7 @@ namespace ml::gfx
 	opengl_shader::~opengl_shader()
 	{
 		ML_glCheck(ML_glDeleteProgram(m_handle));
+		_invalidate_bindings(get_device());
 	}
 
 	bool opengl_shader::compile(uint32 type, size_t count, cstring * str, int32 const * len)
@@ -1389,51 +2874,71 @@ namespace ml::gfx
 
 	void opengl_shader::do_upload(uniform_id loc, bool value)
 	{
+		render_counters::add(_stats(get_device()).uniform_uploads);
+
 		ML_glCheck(glProgramUniform1i(m_handle, ML_handle(int32, loc), (int32)value));
 	}
 
 	void opengl_shader::do_upload(uniform_id loc, int32 value)
 	{
+		render_counters::add(_stats(get_device()).uniform_uploads);
+
 		ML_glCheck(glProgramUniform1i(m_handle, ML_handle(int32, loc), value));
 	}
 
 	void opengl_shader::do_upload(uniform_id loc, uint32 value)
 	{
+		render_counters::add(_stats(get_device()).uniform_uploads);
+
 		ML_glCheck(glProgramUniform1i(m_handle, ML_handle(int32, loc), (int32)value));
 	}
 
 	void opengl_shader::do_upload(uniform_id loc, float32 value)
 	{
+		render_counters::add(_stats(get_device()).uniform_uploads);
+
 		ML_glCheck(glProgramUniform1f(m_handle, ML_handle(int32, loc), value));
 	}
 
 	void opengl_shader::do_upload(uniform_id loc, vec2f const & value)
 	{
+		render_counters::add(_stats(get_device()).uniform_uploads);
+
 		ML_glCheck(glProgramUniform2f(m_handle, ML_handle(int32, loc), value[0], value[1]));
 	}
 
 	void opengl_shader::do_upload(uniform_id loc, vec3f const & value)
 	{
+		render_counters::add(_stats(get_device()).uniform_uploads);
+
 		ML_glCheck(glProgramUniform3f(m_handle, ML_handle(int32, loc), value[0], value[1], value[2]));
 	}
 
 	void opengl_shader::do_upload(uniform_id loc, vec4f const & value)
 	{
+		render_counters::add(_stats(get_device()).uniform_uploads);
+
 		ML_glCheck(glProgramUniform4f(m_handle, ML_handle(int32, loc), value[0], value[1], value[2], value[3]));
 	}
 
 	void opengl_shader::do_upload(uniform_id loc, mat2f const & value, bool transpose)
 	{
+		render_counters::add(_stats(get_device()).uniform_uploads);
+
 		ML_glCheck(glProgramUniformMatrix2fv(m_handle, ML_handle(int32, loc), 1, transpose, value));
 	}
 
 	void opengl_shader::do_upload(uniform_id loc, mat3f const & value, bool transpose)
 	{
+		render_counters::add(_stats(get_device()).uniform_uploads);
+
 		ML_glCheck(glProgramUniformMatrix3fv(m_handle, ML_handle(int32, loc), 1, transpose, value));
 	}
 
 	void opengl_shader::do_upload(uniform_id loc, mat4f const & value, bool transpose)
 	{
+		render_counters::add(_stats(get_device()).uniform_uploads);
+
 		ML_glCheck(glProgramUniformMatrix4fv(m_handle, ML_handle(int32, loc), 1, transpose, value));
 	}
 	
@@ -1441,10 +2946,34 @@ namespace ml::gfx
 	{
 		get_context()->bind_texture(value.get(), slot);
 
+		render_counters::add(_stats(get_device()).uniform_uploads);
+
 		ML_glCheck(glProgramUniform1i(m_handle, ML_handle(int32, loc), (int32)slot));
 	}
 }
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
+// pipeline state
+namespace ml::gfx
+{
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	opengl_pipeline_state::opengl_pipeline_state(render_device * parent, spec_type const & desc, allocator_type alloc)
+		: pipeline_state{ parent }
+		, m_desc		{ desc }
+		, m_hash		{ make_hash(desc) }
+	{
+	}
+
+	opengl_pipeline_state::~opengl_pipeline_state()
+	{
+		_invalidate_bindings(get_device());
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
 #endif // ML_IMPL_RENDERER_OPENGL
\ No newline at end of file
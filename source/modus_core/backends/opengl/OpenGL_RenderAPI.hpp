@@ -6,8 +6,24 @@
 
 #include <modus_core/graphics/RenderAPI.hpp>
 
+#include <mutex>
+
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
+// vertex bindings
+namespace ml::gfx
+{
+	// buffer binding points of a vertex format, each with its own stride and divisor
+	enum vertex_binding_ : uint32
+	{
+		vertex_binding_vertices,	// per vertex data
+		vertex_binding_instances,	// instance buffer
+		vertex_binding_stream,		// instance stream
+
+		vertex_binding_MAX
+	};
+}
+
 // render device
 namespace ml::gfx
 {
@@ -22,18 +38,35 @@ namespace ml::gfx
 
 		ref<render_context> m_context{}; // active context
 
+		render_stats m_stats{}; // last frame stats
+
+		render_counters m_frame_stats{}; // current frame counters
+
+		mutable std::mutex m_stats_mutex{}; // guards published stats
+
+		std::mutex m_programs_mutex{}; // guards program registration against polling
+
+		list<weak<program>> m_polled{}; // programs being polled, render thread only
+
+		flat_map<hash_t, uint32> m_formats{}; // vertexarray objects by vertex format
+
 		batch_vector // all objects
 		<
 			weak<render_context>,
 			weak<vertexarray>,
 			weak<vertexbuffer>,
 			weak<indexbuffer>,
+			weak<uniformbuffer>,
+			weak<streambuffer>,
+			weak<storagebuffer>,
 			weak<texture2d>,
+			weak<texture2d_array>,
 			weak<texture3d>,
 			weak<texturecube>,
 			weak<framebuffer>,
 			weak<program>,
-			weak<shader>
+			weak<shader>,
+			weak<pipeline_state>
 		>
 		m_objs{};
 
@@ -54,6 +87,25 @@ namespace ml::gfx
 
 		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
+		render_stats get_stats() const final
+		{
+			std::unique_lock<std::mutex> lock{ m_stats_mutex };
+			return m_stats;
+		}
+
+		render_counters & get_frame_stats() noexcept final { return m_frame_stats; }
+
+		void flush_stats() final;
+
+		size_t poll_programs() final;
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		// vertexarray object for a vertex format, created once and shared by every vertexarray using it
+		uint32 get_vertex_format(buffer_layout const & vertices, buffer_layout const * instances, buffer_layout const * stream, uint32 stream_location);
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
 		ref<render_context> const & get_context() const noexcept final { return m_context; }
 
 		void set_context(ref<render_context> const & value) noexcept final;
@@ -68,7 +120,15 @@ namespace ml::gfx
 
 		ref<indexbuffer> new_indexbuffer(spec<indexbuffer> const & desc, allocator_type alloc) noexcept final;
 
+		ref<uniformbuffer> new_uniformbuffer(spec<uniformbuffer> const & desc, allocator_type alloc) noexcept final;
+
+		ref<streambuffer> new_streambuffer(spec<streambuffer> const & desc, allocator_type alloc) noexcept final;
+
+		ref<storagebuffer> new_storagebuffer(spec<storagebuffer> const & desc, allocator_type alloc) noexcept final;
+
 		ref<texture2d> new_texture2d(spec<texture2d> const & desc, allocator_type alloc) noexcept final;
+
+		ref<texture2d_array> new_texture2d_array(spec<texture2d_array> const & desc, allocator_type alloc) noexcept final;
 		
 		ref<texture3d> new_texture3d(spec<texture3d> const & desc, allocator_type alloc = {}) noexcept final;
 
@@ -80,6 +140,8 @@ namespace ml::gfx
 
 		ref<shader> new_shader(spec<shader> const & desc, allocator_type alloc) noexcept final;
 
+		ref<pipeline_state> new_pipeline_state(spec<pipeline_state> const & desc, allocator_type alloc) noexcept final;
+
 		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 		list<weak<render_context>> const & all_contexts() const noexcept final { return m_objs.get<weak<render_context>>(); }
@@ -90,8 +152,16 @@ namespace ml::gfx
 
 		list<weak<indexbuffer>> const & all_indexbuffers() const noexcept { return m_objs.get<weak<indexbuffer>>(); }
 
+		list<weak<uniformbuffer>> const & all_uniformbuffers() const noexcept { return m_objs.get<weak<uniformbuffer>>(); }
+
+		list<weak<streambuffer>> const & all_streambuffers() const noexcept { return m_objs.get<weak<streambuffer>>(); }
+
+		list<weak<storagebuffer>> const & all_storagebuffers() const noexcept { return m_objs.get<weak<storagebuffer>>(); }
+
 		list<weak<texture2d>> const & all_texture2ds() const noexcept { return m_objs.get<weak<texture2d>>(); }
 
+		list<weak<texture2d_array>> const & all_texture2d_arrays() const noexcept { return m_objs.get<weak<texture2d_array>>(); }
+
 		list<weak<texture3d>> const & all_texture3ds() const noexcept { return m_objs.get<weak<texture3d>>(); }
 
 		list<weak<texturecube>> const & all_texturecubes() const noexcept { return m_objs.get<weak<texturecube>>(); }
@@ -102,6 +172,8 @@ namespace ml::gfx
 
 		list<weak<shader>> const & all_shaders() const noexcept { return m_objs.get<weak<shader>>(); }
 
+		list<weak<pipeline_state>> const & all_pipeline_states() const noexcept { return m_objs.get<weak<pipeline_state>>(); }
+
 		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 	};
 }
@@ -116,11 +188,81 @@ namespace ml::gfx
 	{
 		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
+	public:
+		// shadowed fixed function state
+		enum state_ : uint32
+		{
+			state_alpha			= 1 << 0,
+			state_blend			= 1 << 1,
+			state_clear_color	= 1 << 2,
+			state_cull			= 1 << 3,
+			state_depth			= 1 << 4,
+			state_stencil		= 1 << 5,
+			state_viewport		= 1 << 6,
+		};
+
+		// cpu side copy of everything the context sets, so redundant calls and
+		// getters never reach the driver, unknown until set or queried once
+		struct state_cache final
+		{
+			static constexpr uint32 unknown{ static_cast<uint32>(-1) };
+
+			static constexpr size_t max_texture_slots{ 32 };
+
+			static constexpr size_t max_uniform_bindings{ 16 };
+
+			static constexpr size_t max_storage_bindings{ 16 };
+
+			uint32			known		; // known state flags
+			alpha_state		alpha		; // alpha state
+			blend_state		blend		; // blend state
+			color			clear_color	; // clear color
+			cull_state		cull		; // cull state
+			depth_state		depth		; // depth state
+			stencil_state	stencil		; // stencil state
+			int_rect		viewport	; // viewport
+
+			uint32 vao, vbo, ibo, fbo, pgm, dib, dsp; // bound objects
+
+			uint32 index_type{ type_uint }; // type of the last bound indices, kept across resets
+
+			uint32 vertex_buffers[vertex_binding_MAX]; // buffers at the bound vertexarray's binding points
+
+			uint32 textures[max_texture_slots]; // bound textures
+
+			struct { uint32 handle; size_t offset, size; } uniforms[max_uniform_bindings]; // bound uniform ranges
+
+			struct { uint32 handle; size_t offset, size; } storages[max_storage_bindings]; // bound storage ranges
+
+			pipeline_hash pipeline; // hashes of the applied pipeline parts, zero once set directly
+
+			pipeline_state const * pso; // bound pipeline state
+
+			void reset() noexcept
+			{
+				known = 0;
+				pipeline = {};
+				reset_bindings();
+			}
+
+			void reset_bindings() noexcept
+			{
+				pso = nullptr;
+				vao = vbo = ibo = fbo = pgm = dib = dsp = unknown;
+				std::fill(std::begin(vertex_buffers), std::end(vertex_buffers), unknown);
+				std::fill(std::begin(textures), std::end(textures), unknown);
+				for (auto & e : uniforms) { e = { unknown, 0, 0 }; }
+				for (auto & e : storages) { e = { unknown, 0, 0 }; }
+			}
+		};
+
 	private:
 		static constexpr typeof_t<> s_self_type{ typeof_v<opengl_render_context> };
 
-		uint32		m_handle	{}; // pipeline handle (WIP)
-		spec_type	m_desc		{}; // context settings
+		uint32				m_handle	{}; // pipeline handle (WIP)
+		spec_type			m_desc		{}; // context settings
+		mutable state_cache	m_cache		{}; // state cache
+		ref<program>		m_fallback	{}; // bound in place of programs that are not ready
 
 		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 		
@@ -141,6 +283,26 @@ namespace ml::gfx
 
 		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
+		void submit(command_buffer const & value) final;
+
+		void invalidate_cache() final { m_cache.reset(); }
+
+		void invalidate_bindings() noexcept { m_cache.reset_bindings(); }
+
+		state_cache const & get_cache() const noexcept { return m_cache; }
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	private:
+		void bind_uniform_range(uint32 handle, uint32 binding, size_t offset, size_t size);
+
+		void bind_vertex_buffer(uint32 binding, uint32 handle, uint32 stride);
+
+		void bind_indirect_buffer(uint32 handle);
+
+	public:
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
 		alpha_state * get_alpha_state(alpha_state * value = {}) const final;
 		
 		blend_state * get_blend_state(blend_state * value = {}) const final;
@@ -175,30 +337,80 @@ namespace ml::gfx
 
 		void clear(uint32 mask) final;
 
-		void draw(ref<vertexarray> const & value) final;
+		using render_context::draw;
+
+		void draw(vertexarray const * value) final;
 
 		void draw_arrays(uint32 prim, size_t first, size_t count) final;
 
 		void draw_indexed(uint32 prim, size_t count) final;
 
+		void draw_instanced(vertexarray const * value, size_t instances, size_t first_instance = 0) final;
+
+		void draw_arrays_instanced(uint32 prim, size_t first, size_t count, size_t instances, size_t first_instance = 0) final;
+
+		void draw_indexed_instanced(uint32 prim, size_t count, size_t instances, size_t first_instance = 0) final;
+
+		void draw_indexed_indirect(uint32 prim, streambuffer const * buffer, size_t offset, size_t count) final;
+
+		void draw_indexed_indirect(uint32 prim, storagebuffer const * buffer, size_t offset, size_t count) final;
+
 		void flush() final;
 
 		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
+		void dispatch(uint32 x, uint32 y = 1, uint32 z = 1) final;
+
+		void dispatch_indirect(storagebuffer const * buffer, size_t offset = 0) final;
+
+		void memory_barrier(uint32 mask = barrier_flags_all) final;
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		sync_id insert_fence() final;
+
+		bool wait_fence(sync_id value, uint64 timeout = 0) final;
+
+		void delete_fence(sync_id value) final;
+
+		query_id new_query() final;
+
+		void delete_query(query_id value) final;
+
+		void query_timestamp(query_id value) final;
+
+		bool get_query_result(query_id value, uint64 & result) final;
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
 		void bind_vertexarray(vertexarray const * value) final;
 
 		void bind_vertexbuffer(vertexbuffer const * value) final;
 
 		void bind_indexbuffer(indexbuffer const * value) final;
 
+		void bind_uniformbuffer(uniformbuffer const * value, uint32 binding, size_t offset = 0, size_t size = 0) final;
+
+		void bind_streambuffer(streambuffer const * value, uint32 binding, size_t offset, size_t size) final;
+
+		void bind_storagebuffer(storagebuffer const * value, uint32 binding, size_t offset = 0, size_t size = 0) final;
+
 		void bind_texture(texture const * value, uint32 slot = 0) final;
 
+		void bind_image(texture const * value, uint32 unit, uint32 access = image_access_read_write, uint32 level = 0) final;
+
 		void bind_framebuffer(framebuffer const * value) final;
 
 		void bind_program(program const * value) final;
+
+		ref<program> const & get_fallback_program() const noexcept final { return m_fallback; }
+
+		void set_fallback_program(ref<program> const & value) final;
 		
 		void bind_shader(shader const * value) final;
 
+		void bind_pipeline_state(pipeline_state const * value) final;
+
 		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 		void upload(uniform_id loc, bool value) final;
@@ -234,11 +446,18 @@ namespace ml::gfx
 	private:
 		static constexpr typeof_t<> s_self_type{ typeof_v<opengl_vertexarray> };
 
-		uint32							m_handle	{}; // handle
-		buffer_layout					m_layout	{}; // buffer layout
-		uint32 const					m_mode		{}; // prim type
-		ref<indexbuffer>			m_indices	{}; // index buffer
-		list<ref<vertexbuffer>>	m_vertices	{}; // vertex buffers
+		uint32							m_handle			{}; // shared format handle
+		buffer_layout					m_layout			{}; // buffer layout
+		uint32 const					m_mode				{}; // prim type
+		ref<indexbuffer>			m_indices			{}; // index buffer
+		list<ref<vertexbuffer>>	m_vertices			{}; // vertex buffers
+		ref<vertexbuffer>			m_instances			{}; // instance buffer
+		buffer_layout					m_instance_layout	{}; // instance layout
+		ref<streambuffer>			m_stream			{}; // stream buffer
+		buffer_layout					m_stream_layout		{}; // stream layout
+		uint32							m_stream_location	{}; // first stream location
+
+		void update_format();
 
 	public:
 		opengl_vertexarray(render_device * parent, spec_type const & desc, allocator_type alloc);
@@ -254,17 +473,29 @@ namespace ml::gfx
 	public:
 		void add_vertices(ref<vertexbuffer> const & value) final;
 
-		void set_layout(buffer_layout const & value) final { m_layout = value; }
+		void set_layout(buffer_layout const & value) final { m_layout = value; update_format(); }
 
 		void set_indices(ref<indexbuffer> const & value) final;
 
+		void set_instances(ref<vertexbuffer> const & value, buffer_layout const & layout) final;
+
+		void set_stream(ref<streambuffer> const & value, buffer_layout const & layout, uint32 first_location) final;
+
 		buffer_layout const & get_layout() const noexcept final { return m_layout; }
 
 		ref<indexbuffer> const & get_indices() const noexcept final { return m_indices; }
 
+		ref<vertexbuffer> const & get_instances() const noexcept final { return m_instances; }
+
+		ref<streambuffer> const & get_stream() const noexcept final { return m_stream; }
+
 		uint32 get_mode() const noexcept final { return m_mode; }
 
 		list<ref<vertexbuffer>> const & get_vertices() const noexcept final { return m_vertices; }
+
+		buffer_layout const & get_instance_layout() const noexcept { return m_instance_layout; }
+
+		buffer_layout const & get_stream_layout() const noexcept { return m_stream_layout; }
 	};
 }
 
@@ -320,6 +551,7 @@ namespace ml::gfx
 
 		uint32			m_handle	{}; // handle
 		uint32 const	m_usage		{}; // usage
+		uint32 const	m_type		{}; // index type
 		buffer_t		m_buffer	{}; // local data
 
 	public:
@@ -338,11 +570,134 @@ namespace ml::gfx
 
 		buffer_t const & get_buffer() const noexcept final { return m_buffer; }
 
-		size_t get_count() const noexcept final { return m_buffer.size() / sizeof(uint32); }
+		size_t get_count() const noexcept final { return m_buffer.size() / get_type_size(m_type); }
 
 		size_t get_size() const noexcept final { return m_buffer.size(); }
 
 		uint32 get_usage() const noexcept final { return m_usage; }
+
+		uint32 get_type() const noexcept final { return m_type; }
+	};
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+// uniformbuffer
+namespace ml::gfx
+{
+	// opengl uniformbuffer
+	struct opengl_uniformbuffer final : uniformbuffer
+	{
+	private:
+		static constexpr typeof_t<> s_self_type{ typeof_v<opengl_uniformbuffer> };
+
+		uint32			m_handle	{}; // handle
+		uint32 const	m_usage		{}; // usage
+		size_t			m_size		{}; // size
+
+	public:
+		opengl_uniformbuffer(render_device * parent, spec_type const & desc, allocator_type alloc);
+
+		~opengl_uniformbuffer() final;
+
+		bool revalue() final;
+
+		object_id get_handle() const noexcept final { return ML_handle(object_id, m_handle); }
+
+		typeof_t<> const & get_self_type() const noexcept final { return s_self_type; }
+
+	public:
+		void set_data(size_t size, addr_t data, size_t offset = 0) final;
+
+		size_t get_size() const noexcept final { return m_size; }
+
+		uint32 get_usage() const noexcept final { return m_usage; }
+	};
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+// streambuffer
+namespace ml::gfx
+{
+	// opengl streambuffer, persistently mapped and fenced per region
+	struct opengl_streambuffer final : streambuffer
+	{
+	private:
+		static constexpr typeof_t<> s_self_type{ typeof_v<opengl_streambuffer> };
+
+		uint32			m_handle	{}; // handle
+		byte *			m_data		{}; // mapped storage
+		size_t const	m_region	{}; // bytes per region
+		list<void *>	m_fences	{}; // region fences
+		size_t			m_frame		{}; // current region
+		size_t			m_head		{}; // bytes used in region
+
+	public:
+		opengl_streambuffer(render_device * parent, spec_type const & desc, allocator_type alloc);
+
+		~opengl_streambuffer() final;
+
+		bool revalue() final;
+
+		object_id get_handle() const noexcept final { return ML_handle(object_id, m_handle); }
+
+		typeof_t<> const & get_self_type() const noexcept final { return s_self_type; }
+
+	public:
+		void next_frame() final;
+
+		stream_range allocate(size_t size, size_t alignment = 16) final;
+
+		size_t get_frame() const noexcept final { return m_frame; }
+
+		size_t get_frame_count() const noexcept final { return m_fences.size(); }
+
+		size_t get_region_size() const noexcept final { return m_region; }
+
+		size_t get_used() const noexcept final { return m_head; }
+
+	private:
+		void create_storage();
+
+		void destroy_storage();
+	};
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+// storagebuffer
+namespace ml::gfx
+{
+	// opengl storagebuffer
+	struct opengl_storagebuffer final : storagebuffer
+	{
+	private:
+		static constexpr typeof_t<> s_self_type{ typeof_v<opengl_storagebuffer> };
+
+		uint32			m_handle	{}; // handle
+		uint32 const	m_usage		{}; // usage
+		size_t			m_size		{}; // size
+
+	public:
+		opengl_storagebuffer(render_device * parent, spec_type const & desc, allocator_type alloc);
+
+		~opengl_storagebuffer() final;
+
+		bool revalue() final;
+
+		object_id get_handle() const noexcept final { return ML_handle(object_id, m_handle); }
+
+		typeof_t<> const & get_self_type() const noexcept final { return s_self_type; }
+
+	public:
+		void set_data(size_t size, addr_t data, size_t offset = 0) final;
+
+		void get_data(size_t size, void * data, size_t offset = 0) const final;
+
+		size_t get_size() const noexcept final { return m_size; }
+
+		uint32 get_usage() const noexcept final { return m_usage; }
 	};
 }
 
@@ -362,6 +717,7 @@ namespace ml::gfx
 		texture_flags_	m_flags		{}			; // 
 		uint32			m_handle	{}			; // handle
 		bool			m_locked	{ true }	; // locked
+		uint64			m_bindless	{}			; // bindless handle
 
 	public:
 		opengl_texture2d(render_device * parent, spec_type const & desc, allocator_type alloc);
@@ -396,6 +752,63 @@ namespace ml::gfx
 		texture_format const & get_format() const noexcept { return m_format; }
 
 		texture_flags_ get_flags() const noexcept { return m_flags; }
+
+		uint64 get_bindless_handle() final;
+	};
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+// texture2d array
+namespace ml::gfx
+{
+	// opengl texture2d array
+	struct opengl_texture2d_array final : texture2d_array
+	{
+	private:
+		static constexpr typeof_t<> s_self_type{ typeof_v<opengl_texture2d_array> };
+
+		vec2i			m_size		{}			; // layer size
+		uint32			m_layers	{}			; // layer count
+		texture_format	m_format	{}			; // format
+		texture_flags_	m_flags		{}			; // flags
+		uint32			m_handle	{}			; // handle
+		bool			m_locked	{ true }	; // locked
+		uint64			m_bindless	{}			; // bindless handle
+
+	public:
+		opengl_texture2d_array(render_device * parent, spec_type const & desc, allocator_type alloc);
+
+		~opengl_texture2d_array() final;
+
+		bool revalue() final;
+
+		object_id get_handle() const noexcept final { return ML_handle(object_id, m_handle); }
+
+		typeof_t<> const & get_self_type() const noexcept final { return s_self_type; }
+
+	public:
+		void lock() final;
+
+		void unlock() final;
+
+		void update(uint32 layer, addr_t data) final;
+
+		void set_mipmapped(bool value) final;
+
+		void set_repeated(bool value) final;
+
+		void set_smooth(bool value) final;
+
+		uint32 get_layers() const noexcept final { return m_layers; }
+
+		vec2i const & get_size() const noexcept final { return m_size; }
+
+		texture_format const & get_format() const noexcept final { return m_format; }
+
+		texture_flags_ get_flags() const noexcept final { return m_flags; }
+
+		uint64 get_bindless_handle() final;
 	};
 }
 
@@ -415,6 +828,7 @@ namespace ml::gfx
 		texture_flags_	m_flags		{}			; // 
 		uint32			m_handle	{}			; // 
 		bool			m_locked	{ true }	; // 
+		uint64			m_bindless	{}			; // bindless handle
 
 	public:
 		opengl_texture3d(render_device * parent, spec_type const & desc, allocator_type alloc);
@@ -437,6 +851,8 @@ namespace ml::gfx
 		texture_format const & get_format() const noexcept { return m_format; }
 
 		texture_flags_ get_flags() const noexcept { return m_flags; }
+
+		uint64 get_bindless_handle() final;
 	};
 }
 
@@ -456,6 +872,7 @@ namespace ml::gfx
 		texture_flags_	m_flags		{}			; // 
 		uint32			m_handle	{}			; // handle
 		bool			m_locked	{ true }	; // locked
+		uint64			m_bindless	{}			; // bindless handle
 
 	public:
 		opengl_texturecube(render_device * parent, spec_type const & desc, allocator_type alloc);
@@ -478,6 +895,8 @@ namespace ml::gfx
 		texture_format const & get_format() const noexcept { return m_format; }
 
 		texture_flags_ get_flags() const noexcept { return m_flags; }
+
+		uint64 get_bindless_handle() final;
 	};
 }
 
@@ -546,21 +965,13 @@ namespace ml::gfx
 		array<object_id, shader_type_MAX>	m_shaders		{}; // shader cache
 		flat_map<uint32, list<string>>	m_source		{}; // source cache
 		flat_map<uniform_id, ref<texture>>	m_textures		{}; // texture cache
-		flat_map<hash_t, uniform_id>				m_uniforms		{}; // uniform cache
-
-		// uniform binder
-		struct ML_NODISCARD program_uniform_binder final
-		{
-			uniform_id location{ ML_handle(uniform_id, -1) };
-
-			uint32 self{}, last{};
+		flat_map<hash_t, uniform_id>				m_uniforms		{}; // uniform locations, reflected at link time
+		flat_map<hash_t, uniform_block>		m_blocks		{}; // uniform blocks, reflected at link time
+		std::atomic<uint32>					m_status		{}; // program status, ready publishes the reflection
 
-			operator bool() const noexcept { return -1 < ML_handle(int32, location); }
+		void reflect_uniforms();
 
-			program_uniform_binder(opengl_program & s, cstring name) noexcept;
-
-			~program_uniform_binder() noexcept;
-		};
+		void reflect_uniform_blocks();
 
 	public:
 		opengl_program(render_device * parent, spec_type const & desc, allocator_type alloc);
@@ -580,11 +991,24 @@ namespace ml::gfx
 
 		bool link() final;
 
+		bool get_binary(uint32 & format, list<byte> & data) const final;
+
+		bool load_binary(uint32 format, addr_t data, size_t size) final;
+
+		void attach_async(uint32 type, size_t count, cstring * str, int32 const * len = {}) final;
+
+		void link_async() final;
+
+		uint32 poll() final;
+
+		uint32 get_status() const noexcept final { return m_status.load(std::memory_order_acquire); }
+
 		bool bind_uniform(cstring name, method<void(uniform_id)> const & fn) final
 		{
-			program_uniform_binder u{ *this, name };
-			if (u) { std::invoke(fn, u.location); }
-			return u;
+			uniform_id const loc{ get_uniform_location(name) };
+			if (ML_handle(int32, loc) < 0) { return false; }
+			std::invoke(fn, loc);
+			return true;
 		}
 
 		uniform_id get_uniform_location(cstring name) noexcept final;
@@ -599,6 +1023,10 @@ namespace ml::gfx
 
 		flat_map<hash_t, uniform_id> const & get_uniforms() const noexcept final { return m_uniforms; }
 
+		flat_map<hash_t, uniform_block> const & get_uniform_blocks() const noexcept final { return m_blocks; }
+
+		bool bind_uniform_block(cstring name, uint32 binding) final;
+
 		uint32 get_mask() const noexcept final
 		{
 			auto const & s{ get_shaders() };
@@ -606,9 +1034,29 @@ namespace ml::gfx
 			ML_flag_write(mask, shader_bit_vertex	, s[shader_type_vertex]);
 			ML_flag_write(mask, shader_bit_pixel	, s[shader_type_pixel]);
 			ML_flag_write(mask, shader_bit_geometry	, s[shader_type_geometry]);
+			ML_flag_write(mask, shader_bit_compute	, s[shader_type_compute]);
 			return mask;
 		}
 
+	public:
+		void upload(uniform_id loc, bool value) final;
+
+		void upload(uniform_id loc, int32 value) final;
+
+		void upload(uniform_id loc, float32 value) final;
+
+		void upload(uniform_id loc, vec2f const & value) final;
+
+		void upload(uniform_id loc, vec3f const & value) final;
+
+		void upload(uniform_id loc, vec4f const & value) final;
+
+		void upload(uniform_id loc, mat2f const & value) final;
+
+		void upload(uniform_id loc, mat3f const & value) final;
+
+		void upload(uniform_id loc, mat4f const & value) final;
+
 	public:
 		void do_cache_texture(uniform_id loc, ref<texture> const & value) noexcept final
 		{
@@ -694,6 +1142,7 @@ namespace ml::gfx
 			ML_flag_write(mask, shader_bit_vertex	, m_type == shader_type_vertex);
 			ML_flag_write(mask, shader_bit_pixel	, m_type == shader_type_pixel);
 			ML_flag_write(mask, shader_bit_geometry	, m_type == shader_type_geometry);
+			ML_flag_write(mask, shader_bit_compute	, m_type == shader_type_compute);
 			return mask;
 		}
 
@@ -740,5 +1189,35 @@ namespace ml::gfx
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
+// pipeline state
+namespace ml::gfx
+{
+	// opengl pipeline state, plain cpu data applied by the context
+	struct opengl_pipeline_state final : pipeline_state
+	{
+	private:
+		static constexpr typeof_t<> s_self_type{ typeof_v<opengl_pipeline_state> };
+
+		spec_type		m_desc	; // settings
+		pipeline_hash	m_hash	; // precomputed hashes
+
+	public:
+		opengl_pipeline_state(render_device * parent, spec_type const & desc, allocator_type alloc);
+
+		~opengl_pipeline_state() final;
+
+		object_id get_handle() const noexcept final { return ML_handle(object_id, this); }
+
+		typeof_t<> const & get_self_type() const noexcept final { return s_self_type; }
+
+	public:
+		spec_type const & get_spec() const noexcept final { return m_desc; }
+
+		pipeline_hash const & get_hash() const noexcept final { return m_hash; }
+	};
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
 #endif // !_ML_IMPL_RENDERER_OPENGL_HPP_
 #endif // _ML_OPENGL_RENDER_API_HPP_
\ No newline at end of file
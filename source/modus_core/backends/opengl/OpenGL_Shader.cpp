@@ -28,6 +28,7 @@ namespace ml::gfx
 			case hashof("vertex")	: type = shader_type_vertex; break;
 			case hashof("pixel")	: type = shader_type_pixel; break;
 			case hashof("geometry")	: type = shader_type_geometry; break;
+			case hashof("compute")	: type = shader_type_compute; break;
 			}
 		}
 
@@ -0,0 +1,14 @@
+#ifndef _ML_OSMESA_HPP_
+#define _ML_OSMESA_HPP_
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <modus_core/Standard.hpp>
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <GL/osmesa.h>
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#endif // !_ML_OSMESA_HPP_
\ No newline at end of file
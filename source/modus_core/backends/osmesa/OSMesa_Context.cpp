@@ -0,0 +1,120 @@
+#ifdef ML_IMPL_HEADLESS_OSMESA
+
+#include "./OSMesa.hpp"
+#include "./OSMesa_Context.hpp"
+
+// OSMESA CONTEXT
+namespace ml
+{
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	osmesa_context::osmesa_context(allocator_type alloc) noexcept
+		: m_context	{}
+		, m_buffer	{ alloc }
+		, m_size	{}
+	{
+	}
+
+	osmesa_context::~osmesa_context()
+	{
+		close();
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	bool osmesa_context::open(vec2i const & size, context_settings const & cs)
+	{
+		// check already open
+		if (is_open()) { return debug::fail("osmesa context is already open"); }
+
+		// size
+		m_size = { (std::max)(size[0], 1), (std::max)(size[1], 1) };
+
+		// context
+		auto const create_context = [&](int32 profile, bool versioned) -> OSMesaContext
+		{
+			int32 context_attribs[]
+			{
+				OSMESA_FORMAT,					OSMESA_RGBA,
+				OSMESA_DEPTH_BITS,				cs.depth_bits,
+				OSMESA_STENCIL_BITS,			cs.stencil_bits,
+				OSMESA_ACCUM_BITS,				0,
+				OSMESA_PROFILE,					(profile == context_profile_core)
+					? OSMESA_CORE_PROFILE
+					: OSMESA_COMPAT_PROFILE,
+				OSMESA_CONTEXT_MAJOR_VERSION,	cs.major,
+				OSMESA_CONTEXT_MINOR_VERSION,	cs.minor,
+				0
+			};
+			if (!versioned) { context_attribs[10] = 0; }
+
+			return OSMesaCreateContextAttribs(context_attribs, nullptr);
+		};
+
+		// same fallbacks as egl, llvmpipe behind osmesa has the same limits
+		if (!(m_context = create_context(cs.profile, true)) && cs.profile != context_profile_core)
+		{
+			m_context = create_context(context_profile_core, true);
+		}
+		if (!m_context)
+		{
+			m_context = create_context(cs.profile, false);
+		}
+		if (!m_context)
+		{
+			return debug::fail("failed creating osmesa context {0}.{1}", cs.major, cs.minor);
+		}
+
+		// buffer
+		m_buffer.resize((size_t)m_size[0] * (size_t)m_size[1] * 4);
+
+		// make current context
+		if (!make_current())
+		{
+			close();
+			return debug::fail("failed making osmesa context current");
+		}
+
+		// success
+		return true;
+	}
+
+	void osmesa_context::close()
+	{
+		if (!m_context) { return; }
+
+		if (is_current()) { release_current(); }
+
+		OSMesaDestroyContext((OSMesaContext)m_context);
+
+		m_context = {};
+		m_buffer.clear();
+		m_size = {};
+	}
+
+	bool osmesa_context::make_current()
+	{
+		return m_context && OSMesaMakeCurrent(
+			(OSMesaContext)m_context,
+			m_buffer.data(),
+			GL_UNSIGNED_BYTE,
+			m_size[0],
+			m_size[1]);
+	}
+
+	void osmesa_context::release_current()
+	{
+		OSMesaMakeCurrent(nullptr, nullptr, GL_UNSIGNED_BYTE, 0, 0);
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	bool osmesa_context::is_current() const
+	{
+		return m_context && OSMesaGetCurrentContext() == (OSMesaContext)m_context;
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+}
+
+#endif // ML_IMPL_HEADLESS_OSMESA
\ No newline at end of file
@@ -0,0 +1,52 @@
+#ifndef _ML_OSMESA_CONTEXT_HPP_
+#define _ML_OSMESA_CONTEXT_HPP_
+
+#include <modus_core/window/HeadlessContext.hpp>
+
+namespace ml
+{
+	// osmesa headless context
+	struct osmesa_context final : base_headless_context
+	{
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		using base_headless_context::allocator_type;
+
+		osmesa_context(allocator_type alloc = {}) noexcept;
+
+		~osmesa_context() final;
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		bool open(vec2i const & size, context_settings const & cs = {}) final;
+
+		void close() final;
+
+		bool make_current() final;
+
+		void release_current() final;
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		int32 get_backend() const final { return headless_backend_osmesa; }
+
+		void * get_handle() const final { return m_context; }
+
+		vec2i get_size() const final { return m_size; }
+
+		bool is_current() const final;
+
+		bool is_open() const final { return m_context != nullptr; }
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	private:
+		void *		m_context	; // OSMesaContext
+		list<byte>	m_buffer	; // default framebuffer pixels
+		vec2i		m_size		; // buffer size
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+	};
+}
+
+#endif // !_ML_OSMESA_CONTEXT_HPP_
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include <modus_core/embed/Python.hpp>
+#include <modus_core/graphics/RenderAPI.hpp>
 #include <modus_core/runtime/CoreApplication.hpp>
+#include <modus_core/system/JobSystem.hpp>
 #include <modus_core/window/WindowAPI.hpp>
 
 PYBIND11_EMBEDDED_MODULE(modus, m)
@@ -222,6 +224,47 @@ PYBIND11_EMBEDDED_MODULE(modus, m)
 
 	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
+	// JOBS
+
+	auto py_jobs{ m.def_submodule("jobs") };
+
+	py::class_<job_counter, job_handle>(py_jobs, "handle")
+		.def("done", &job_counter::done)
+		.def("__bool__", &job_counter::done)
+		;
+
+	py_jobs // jobs
+		.def("worker_count", []() { return ML_get_global(job_system)->get_worker_count(); })
+		.def("worker_index", []() { return ML_get_global(job_system)->get_worker_index(); })
+		.def("schedule", [](py::function fn, int32 affinity)
+		{
+			// the function may be copied or released on a worker, so hold it under the gil
+			ref<py::function> const f{ new py::function{ std::move(fn) }, [](py::function * p)
+			{
+				py::gil_scoped_acquire gil; delete p;
+			} };
+			return ML_get_global(job_system)->schedule([f]()
+			{
+				py::gil_scoped_acquire gil; (*f)();
+			}, {}, affinity);
+		}, py::arg("fn"), py::arg("affinity") = (int32)job_system::any_worker)
+		.def("wait", [](job_handle const & h)
+		{
+			py::gil_scoped_release nogil;
+			ML_get_global(job_system)->wait(h);
+		})
+		.def("parallel_for", [](size_t first, size_t last, py::function fn, size_t grain)
+		{
+			py::gil_scoped_release nogil;
+			ML_get_global(job_system)->parallel_for(first, last, [&fn](size_t i)
+			{
+				py::gil_scoped_acquire gil; fn(i);
+			}, grain);
+		}, py::arg("first"), py::arg("last"), py::arg("fn"), py::arg("grain") = (size_t)0)
+		;
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
 	//py::class_<event, non_copyable>(m, "event")
 	//	.def("__int__", &event::operator hash_t)
 	//	;
@@ -458,4 +501,31 @@ PYBIND11_EMBEDDED_MODULE(modus, m)
 		;
 
 	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	// RENDER STATS
+	py::class_<gfx::render_stats>(m, "render_stats")
+		.def(py::init<>())
+		.def_readonly("draw_calls"			, &gfx::render_stats::draw_calls)
+		.def_readonly("primitives"			, &gfx::render_stats::primitives)
+		.def_readonly("dispatches"			, &gfx::render_stats::dispatches)
+		.def_readonly("program_binds"		, &gfx::render_stats::program_binds)
+		.def_readonly("texture_binds"		, &gfx::render_stats::texture_binds)
+		.def_readonly("vertexarray_binds"	, &gfx::render_stats::vertexarray_binds)
+		.def_readonly("framebuffer_binds"	, &gfx::render_stats::framebuffer_binds)
+		.def_readonly("uniform_uploads"		, &gfx::render_stats::uniform_uploads)
+		.def_readonly("bytes_uploaded"		, &gfx::render_stats::bytes_uploaded)
+		.def_readonly("objects_created"		, &gfx::render_stats::objects_created)
+		.def_readonly("objects_destroyed"	, &gfx::render_stats::objects_destroyed)
+		.def("__repr__", [](gfx::render_stats const & o) { return json(o).dump(); })
+		.def("__str__", [](gfx::render_stats const & o) { return json(o).dump(); })
+		;
+
+	// counters of the last completed frame
+	m.def("render_stats_last_frame", []() -> gfx::render_stats
+	{
+		auto const device{ ML_get_global(gfx::render_device) };
+		return device ? device->get_stats() : gfx::render_stats{};
+	});
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 }
\ No newline at end of file
@@ -38,6 +38,15 @@ namespace ml
 		constexpr runtime_idle_event(gui_application * ptr) noexcept : ptr{ ptr } {}
 	};
 
+	ML_event(runtime_fixed_update_event)
+	{
+		gui_application * const ptr;
+		duration const dt; // fixed step
+		auto operator->() const noexcept { return ptr; }
+		auto & operator*() const noexcept { return *ML_check(ptr); }
+		constexpr runtime_fixed_update_event(gui_application * ptr, duration dt) noexcept : ptr{ ptr }, dt{ dt } {}
+	};
+
 	ML_event(runtime_gui_event)
 	{
 		gui_application * const ptr;
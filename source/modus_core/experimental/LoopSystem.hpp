@@ -3,7 +3,10 @@
 
 #include <modus_core/detail/Duration.hpp>
 #include <modus_core/detail/Method.hpp>
-#include <modus_core/system/Memory.hpp>
+#include <modus_core/detail/TypeInfo.hpp>
+#include <modus_core/system/JobSystem.hpp>
+
+#include <future>
 
 namespace ml
 {
@@ -17,8 +20,12 @@ namespace ml
 		using enter_callback			= typename method<void()>;
 		using exit_callback				= typename method<void()>;
 		using idle_callback				= typename method<void()>;
+		using executor					= typename method<void(size_t, method<void(size_t)> const &)>;
 		using subsystem					= typename ref<loop_system>;
 		using subsystem_list			= typename list<subsystem>;
+		using dependency_list			= typename list<weak<loop_system>>;
+		using resource_list				= typename list<hash_t>;
+		using execution_plan			= typename list<list<size_t>>;
 		using iterator					= typename subsystem_list::iterator;
 		using const_iterator			= typename subsystem_list::const_iterator;
 		using reverse_iterator			= typename subsystem_list::reverse_iterator;
@@ -35,6 +42,13 @@ namespace ml
 			, m_on_enter	{}
 			, m_on_exit		{}
 			, m_on_idle		{}
+			, m_dependencies{ alloc }
+			, m_reads		{ alloc }
+			, m_writes		{ alloc }
+			, m_executor	{}
+			, m_plan		{ alloc }
+			, m_plan_dirty	{ true }
+			, m_parent		{}
 		{
 		}
 
@@ -45,6 +59,13 @@ namespace ml
 			, m_on_enter	{ other.m_on_enter }
 			, m_on_exit		{ other.m_on_exit }
 			, m_on_idle		{ other.m_on_idle }
+			, m_dependencies{ other.m_dependencies, alloc }
+			, m_reads		{ other.m_reads, alloc }
+			, m_writes		{ other.m_writes, alloc }
+			, m_executor	{ other.m_executor }
+			, m_plan		{ alloc }
+			, m_plan_dirty	{ true }
+			, m_parent		{}
 		{
 		}
 
@@ -75,10 +96,20 @@ namespace ml
 			{
 				std::swap(m_running, other.m_running);
 				m_subsystems.swap(other.m_subsystems);
-				m_condition.swap(m_condition);
-				m_on_enter.swap(m_on_enter);
-				m_on_exit.swap(m_on_exit);
-				m_on_idle.swap(m_on_idle);
+				m_condition.swap(other.m_condition);
+				m_on_enter.swap(other.m_on_enter);
+				m_on_exit.swap(other.m_on_exit);
+				m_on_idle.swap(other.m_on_idle);
+				m_dependencies.swap(other.m_dependencies);
+				m_reads.swap(other.m_reads);
+				m_writes.swap(other.m_writes);
+				m_executor.swap(other.m_executor);
+				m_plan.swap(other.m_plan);
+				std::swap(m_plan_dirty, other.m_plan_dirty);
+				for (subsystem & e : m_subsystems) { e->m_parent = this; }
+				for (subsystem & e : other.m_subsystems) { e->m_parent = std::addressof(other); }
+				invalidate_plan();
+				other.invalidate_plan();
 			}
 		}
 
@@ -142,7 +173,10 @@ namespace ml
 		template <bool Recursive = false, bool Reverse = false
 		> void run_idle_callback() noexcept
 		{
-			loop_system::run<Recursive, Reverse>(&loop_system::m_on_idle, this);
+			// waves run on other threads, which must only read plans
+			if constexpr (Recursive) { this->update_plan(); }
+
+			loop_system::run<Recursive, Reverse, true>(&loop_system::m_on_idle, this);
 		}
 
 		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
@@ -183,6 +217,108 @@ namespace ml
 
 		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
+		ML_NODISCARD auto get_dependencies() const noexcept -> dependency_list const & { return m_dependencies; }
+
+		ML_NODISCARD auto get_reads() const noexcept -> resource_list const & { return m_reads; }
+
+		ML_NODISCARD auto get_writes() const noexcept -> resource_list const & { return m_writes; }
+
+		ML_NODISCARD auto get_executor() const noexcept -> executor const & { return m_executor; }
+
+		// run after other
+		auto add_dependency(subsystem const & other) noexcept -> loop_system &
+		{
+			if (other && other.get() != this && !depends_on(other.get())) {
+				m_dependencies.emplace_back(other);
+				invalidate_plan();
+			}
+			return (*this);
+		}
+
+		// declare read access to a shared resource
+		auto add_read(hash_t resource) noexcept -> loop_system &
+		{
+			if (std::find(m_reads.begin(), m_reads.end(), resource) == m_reads.end()) {
+				m_reads.push_back(resource);
+				invalidate_plan();
+			}
+			return (*this);
+		}
+
+		// declare write access to a shared resource
+		auto add_write(hash_t resource) noexcept -> loop_system &
+		{
+			if (std::find(m_writes.begin(), m_writes.end(), resource) == m_writes.end()) {
+				m_writes.push_back(resource);
+				invalidate_plan();
+			}
+			return (*this);
+		}
+
+		template <class T> auto add_read() noexcept -> loop_system & { return add_read(hashof_v<T>); }
+
+		template <class T> auto add_write() noexcept -> loop_system & { return add_write(hashof_v<T>); }
+
+		ML_NODISCARD bool depends_on(loop_system const * other) const noexcept
+		{
+			return m_dependencies.end() != std::find_if(m_dependencies.begin(), m_dependencies.end(),
+				[other](weak<loop_system> const & e) noexcept { return e.lock().get() == other; });
+		}
+
+		// true if both systems touch a resource and at least one of them writes it
+		ML_NODISCARD bool conflicts_with(loop_system const & other) const noexcept
+		{
+			auto contains = [](resource_list const & l, hash_t h) noexcept
+			{
+				return std::find(l.begin(), l.end(), h) != l.end();
+			};
+			for (hash_t const h : m_writes) {
+				if (contains(other.m_reads, h) || contains(other.m_writes, h)) { return true; }
+			}
+			for (hash_t const h : m_reads) {
+				if (contains(other.m_writes, h)) { return true; }
+			}
+			return false;
+		}
+
+		// used to run independent subsystems concurrently, falls back to the job system
+		void set_executor(executor const & value, bool recursive = true) noexcept
+		{
+			m_executor = value;
+
+			if (recursive) for (subsystem & e : m_subsystems)
+			{
+				e->set_executor(value, true);
+			}
+		}
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		// subsystems grouped into waves which may run concurrently
+		ML_NODISCARD auto get_plan() -> execution_plan const &
+		{
+			if (m_plan_dirty) { build_plan(); }
+			return m_plan;
+		}
+
+		// rebuild this plan and every plan below it on the calling thread
+		void update_plan()
+		{
+			if (m_plan_dirty) { build_plan(); }
+
+			for (subsystem & e : m_subsystems) { e->update_plan(); }
+		}
+
+		// rebuild the plan on next run, the parent orders this system so it is rebuilt too
+		void invalidate_plan() noexcept
+		{
+			for (loop_system * e{ this }; e; e = e->m_parent) { e->m_plan_dirty = true; }
+		}
+
+		ML_NODISCARD auto get_parent() const noexcept -> loop_system * { return m_parent; }
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
 		ML_NODISCARD auto subsystems() & noexcept -> subsystem_list & { return m_subsystems; }
 
 		ML_NODISCARD auto subsystems() const & noexcept -> subsystem_list const & { return m_subsystems; }
@@ -196,7 +332,12 @@ namespace ml
 			if (this == value.get()) { return nullptr; }
 			else if (auto const it{ find_subsystem(value) }
 			; it != m_subsystems.end()) { return *it; }
-			else { return m_subsystems.emplace_back(value); }
+			else {
+				if (value && !value->m_executor) { value->set_executor(m_executor); }
+				if (value) { value->m_parent = this; }
+				invalidate_plan();
+				return m_subsystems.emplace_back(value);
+			}
 		}
 
 		auto delete_subsystem(subsystem const & value) noexcept -> iterator
@@ -204,7 +345,12 @@ namespace ml
 			if (this == value.get()) { return m_subsystems.end(); }
 			else if (auto const it{ find_subsystem(value) }
 			; it == m_subsystems.end()) { return it; }
-			else { return m_subsystems.erase(it); }
+			else
+			{
+				if ((*it)->m_parent == this) { (*it)->m_parent = nullptr; }
+				invalidate_plan();
+				return m_subsystems.erase(it);
+			}
 		}
 
 		template <class Derived = loop_system, class ... Args
@@ -212,7 +358,7 @@ namespace ml
 		{
 			static_assert(std::is_base_of_v<loop_system, Derived>);
 
-			return std::static_pointer_cast<Derived>(m_subsystems.emplace_back
+			return std::static_pointer_cast<Derived>(add_subsystem
 			(
 				_ML make_ref<Derived>(ML_forward(args)...)
 			));
@@ -262,6 +408,7 @@ namespace ml
 		template <
 			bool Recursive = false,
 			bool Reverse = false,
+			bool Parallel = false,
 			class D, class C, class ... Args
 		> static void run(D C::*mp, C * self, Args && ... args) noexcept
 		{
@@ -269,37 +416,43 @@ namespace ml
 
 			if (!self || !mp) { return; } // nothing to do
 
-			auto run_self{ std::bind(self->*mp, ML_forward(args)...) };
+			auto run_self = [&]() noexcept
+			{
+				if (auto const & fn{ self->*mp }) { std::invoke(fn, args...); }
+			};
 
 			if constexpr (!Reverse) { run_self(); }
 
 			if constexpr (Recursive)
 			{
-				using Iter = std::conditional_t<!Reverse,
-					subsystem_list::const_iterator,
-					subsystem_list::const_reverse_iterator>;
-
-				auto first = [&]() noexcept -> Iter {
-					if constexpr (Reverse) { return self->m_subsystems.rbegin(); }
-					else { return self->m_subsystems.begin(); }
-				};
-
-				auto last = [&]() noexcept -> Iter {
-					if constexpr (Reverse) { return self->m_subsystems.rend(); }
-					else { return self->m_subsystems.end(); }
-				};
-
-				std::for_each(first(), last(), [&](subsystem const & e) noexcept
+				auto run_child = [&](size_t i) noexcept
 				{
+					subsystem const & e{ self->m_subsystems[i] };
+
 					if constexpr (std::is_same_v<C, loop_system>)
 					{
-						loop_system::run<true, Reverse>(mp, self, ML_forward(args)...); // skip cast
+						loop_system::run<true, Reverse, Parallel>(mp, e.get(), args...); // skip cast
 					}
 					else
 					{
-						loop_system::run<true, Reverse>(mp, dynamic_cast<C *>(e.get()), ML_forward(args)...);
+						loop_system::run<true, Reverse, Parallel>(mp, dynamic_cast<C *>(e.get()), args...);
 					}
-				});
+				};
+
+				execution_plan const & plan{ self->get_plan() };
+
+				if constexpr (Reverse)
+				{
+					std::for_each(plan.rbegin(), plan.rend(), [&](auto const & wave) noexcept
+					{
+						std::for_each(wave.rbegin(), wave.rend(), run_child);
+					});
+				}
+				else for (auto const & wave : plan)
+				{
+					if constexpr (Parallel) { self->execute_wave(wave, run_child); }
+					else { std::for_each(wave.begin(), wave.end(), run_child); }
+				}
 			}
 
 			if constexpr (Reverse) { run_self(); }
@@ -307,6 +460,97 @@ namespace ml
 
 		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
+		// run every subsystem in a wave and wait for all of them
+		template <class Fn
+		> void execute_wave(list<size_t> const & wave, Fn && fn) noexcept
+		{
+			if (wave.empty()) { return; }
+			else if (wave.size() == 1) { return fn(wave.front()); }
+			else if (m_executor)
+			{
+				m_executor(wave.size(), [&](size_t i) { fn(wave[i]); });
+			}
+			else if (job_system * const jobs{ ML_get_global(job_system) })
+			{
+				jobs->parallel_for(0, wave.size(), [&](size_t i) { fn(wave[i]); }, 1);
+			}
+			else
+			{
+				// may run off the main thread, keep scratch off the default resource
+				byte buffer[16 * sizeof(std::future<void>)];
+				pmr::monotonic_buffer_resource mres{ buffer, sizeof(buffer), pmr::new_delete_resource() };
+				list<std::future<void>> tasks{ &mres };
+				tasks.reserve(wave.size() - 1);
+				for (size_t i = 1; i < wave.size(); ++i)
+				{
+					tasks.emplace_back(std::async(std::launch::async, [&, i]() { fn(wave[i]); }));
+				}
+				fn(wave.front());
+				for (auto & e : tasks) { e.wait(); }
+			}
+		}
+
+		// build dependency graph and group it into waves
+		void build_plan()
+		{
+			m_plan_dirty = false;
+			m_plan.clear();
+
+			// scratch lives on the stack, spilling into the heap for large graphs
+			byte buffer[1024];
+			pmr::monotonic_buffer_resource mres{ buffer, sizeof(buffer), pmr::new_delete_resource() };
+
+			size_t const count{ m_subsystems.size() };
+			list<list<size_t>> edges(count, &mres);
+			list<size_t> indegree(count, 0, &mres);
+			auto add_edge = [&](size_t from, size_t to)
+			{
+				edges[from].push_back(to);
+				++indegree[to];
+			};
+
+			// explicit dependencies first, resource conflicts keep list order
+			for (size_t i = 0; i < count; ++i)
+			{
+				loop_system const & a{ *m_subsystems[i] };
+				for (size_t j = i + 1; j < count; ++j)
+				{
+					loop_system const & b{ *m_subsystems[j] };
+					if (b.depends_on(&a)) { add_edge(i, j); }
+					else if (a.depends_on(&b)) { add_edge(j, i); }
+					else if (a.conflicts_with(b)) { add_edge(i, j); }
+				}
+			}
+
+			// kahn, one level at a time
+			size_t scheduled{};
+			list<size_t> wave{ &mres };
+			for (size_t i = 0; i < count; ++i) { if (!indegree[i]) { wave.push_back(i); } }
+			while (!wave.empty())
+			{
+				scheduled += wave.size();
+				list<size_t> next{ &mres };
+				for (size_t const i : wave) {
+					for (size_t const j : edges[i]) {
+						if (!--indegree[j]) { next.push_back(j); }
+					}
+				}
+				std::sort(next.begin(), next.end());
+				m_plan.emplace_back(std::move(wave));
+				wave = std::move(next);
+			}
+
+			// cycle
+			if (scheduled != count)
+			{
+				debug::fail("loop_system dependency cycle, falling back to list order");
+				m_plan.clear();
+				for (size_t i = 0; i < count; ++i) { m_plan.push_back({ i }); }
+			}
+		}
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
 	private:
 		bool					m_running		; // running
 		subsystem_list			m_subsystems	; // subsystem list
@@ -314,6 +558,13 @@ namespace ml
 		enter_callback			m_on_enter		; // enter callback
 		exit_callback			m_on_exit		; // exit callback
 		idle_callback			m_on_idle		; // idle callback
+		dependency_list			m_dependencies	; // run after these
+		resource_list			m_reads			; // resources read
+		resource_list			m_writes		; // resources written
+		executor				m_executor		; // concurrent executor
+		execution_plan			m_plan			; // execution plan
+		bool					m_plan_dirty	; // plan needs rebuilding
+		loop_system *			m_parent		; // owning system
 
 		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 	};
@@ -0,0 +1,459 @@
+#ifndef _ML_COMMAND_BUFFER_HPP_
+#define _ML_COMMAND_BUFFER_HPP_
+
+#include <modus_core/graphics/RenderCommand.hpp>
+
+// COMMAND TYPES
+namespace ml::gfx
+{
+	enum command_type_ : uint32
+	{
+		command_type_callback,
+
+		command_type_set_alpha_state,
+		command_type_set_blend_state,
+		command_type_set_clear_color,
+		command_type_set_cull_state,
+		command_type_set_depth_state,
+		command_type_set_stencil_state,
+		command_type_set_viewport,
+
+		command_type_clear,
+		command_type_draw,
+		command_type_draw_arrays,
+		command_type_draw_indexed,
+		command_type_draw_instanced,
+		command_type_draw_arrays_instanced,
+		command_type_draw_indexed_instanced,
+		command_type_draw_indexed_indirect,
+		command_type_flush,
+
+		command_type_dispatch,
+		command_type_dispatch_indirect,
+		command_type_memory_barrier,
+
+		command_type_bind_vertexarray,
+		command_type_bind_vertexbuffer,
+		command_type_bind_indexbuffer,
+		command_type_bind_texture,
+		command_type_bind_image,
+		command_type_bind_uniformbuffer,
+		command_type_bind_streambuffer,
+		command_type_bind_storagebuffer,
+		command_type_bind_framebuffer,
+		command_type_bind_program,
+		command_type_bind_shader,
+		command_type_bind_pipeline_state,
+
+		command_type_upload_bool,
+		command_type_upload_int,
+		command_type_upload_float,
+		command_type_upload_vec2,
+		command_type_upload_vec3,
+		command_type_upload_vec4,
+		command_type_upload_mat2,
+		command_type_upload_mat3,
+		command_type_upload_mat4,
+
+		command_type_MAX
+	};
+}
+
+// COMMAND PACKETS
+namespace ml::gfx
+{
+	// packet header, followed by the payload
+	struct ML_NODISCARD command_header final
+	{
+		uint32 type	; // command type
+		uint32 size	; // size in words, including header
+	};
+
+	struct ML_NODISCARD command_draw_arrays final
+	{
+		uint32 prim; size_t first, count;
+	};
+
+	struct ML_NODISCARD command_draw_indexed final
+	{
+		uint32 prim; size_t count;
+	};
+
+	struct ML_NODISCARD command_draw_instanced final
+	{
+		vertexarray const * value; size_t instances, first_instance;
+	};
+
+	struct ML_NODISCARD command_draw_arrays_instanced final
+	{
+		uint32 prim; size_t first, count, instances, first_instance;
+	};
+
+	struct ML_NODISCARD command_draw_indexed_instanced final
+	{
+		uint32 prim; size_t count, instances, first_instance;
+	};
+
+	struct ML_NODISCARD command_draw_indexed_indirect final
+	{
+		uint32 prim; streambuffer const * buffer; size_t offset, count;
+	};
+
+	struct ML_NODISCARD command_dispatch final
+	{
+		uint32 x, y, z;
+	};
+
+	struct ML_NODISCARD command_dispatch_indirect final
+	{
+		storagebuffer const * buffer; size_t offset;
+	};
+
+	struct ML_NODISCARD command_bind_texture final
+	{
+		texture const * value; uint32 slot;
+	};
+
+	struct ML_NODISCARD command_bind_image final
+	{
+		texture const * value; uint32 unit, access, level;
+	};
+
+	struct ML_NODISCARD command_bind_uniformbuffer final
+	{
+		uniformbuffer const * value; uint32 binding; size_t offset, size;
+	};
+
+	struct ML_NODISCARD command_bind_streambuffer final
+	{
+		streambuffer const * value; uint32 binding; size_t offset, size;
+	};
+
+	struct ML_NODISCARD command_bind_storagebuffer final
+	{
+		storagebuffer const * value; uint32 binding; size_t offset, size;
+	};
+
+	template <class T
+	> struct ML_NODISCARD command_upload final
+	{
+		uniform_id loc; T value;
+	};
+}
+
+// COMMAND BUFFER
+namespace ml::gfx
+{
+	// linear buffer of tagged packets
+	// objects are recorded by address, shared ones are also held until the buffer is cleared,
+	// anything passed by raw pointer must outlive execution
+	// clearing keeps capacity, so steady state recording does not allocate
+	struct ML_NODISCARD command_buffer final
+	{
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		using allocator_type = typename pmr::polymorphic_allocator<byte>;
+
+		command_buffer(allocator_type alloc = {}) noexcept
+			: m_data		{ alloc }
+			, m_callbacks	{ alloc }
+			, m_refs		{ alloc }
+			, m_count		{}
+		{
+		}
+
+		command_buffer(command_buffer const &) = default;
+
+		command_buffer(command_buffer &&) noexcept = default;
+
+		command_buffer & operator=(command_buffer const &) = default;
+
+		command_buffer & operator=(command_buffer &&) noexcept = default;
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		void clear() noexcept
+		{
+			m_data.clear();
+			m_callbacks.clear();
+			m_refs.clear();
+			m_count = 0;
+		}
+
+		void reserve(size_t words, size_t callbacks = 0)
+		{
+			m_data.reserve(words);
+			m_callbacks.reserve(callbacks);
+		}
+
+		ML_NODISCARD bool empty() const noexcept { return !m_count; }
+
+		ML_NODISCARD auto size() const noexcept -> size_t { return m_count; }
+
+		ML_NODISCARD auto capacity() const noexcept -> size_t { return m_data.capacity() * sizeof(uint64); }
+
+		ML_NODISCARD auto get_callback(size_t i) const noexcept -> command const & { return m_callbacks[i]; }
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		// current write position in words, used to address a range of packets
+		ML_NODISCARD auto get_offset() const noexcept -> size_t { return m_data.size(); }
+
+		// invoke fn(header, payload) for every packet in [first, last) in order
+		template <class Fn
+		> void for_each(Fn && fn, size_t first = 0, size_t last = static_cast<size_t>(-1)) const
+		{
+			last = (std::min)(last, m_data.size());
+			for (uint64 const * it{ m_data.data() + first }, * const end{ m_data.data() + last }; it < end;)
+			{
+				command_header const & h{ *reinterpret_cast<command_header const *>(it) };
+
+				fn(h, static_cast<void const *>(it + 1));
+
+				it += h.size;
+			}
+		}
+
+		template <class T
+		> ML_NODISCARD static T const & read(void const * payload) noexcept
+		{
+			return *static_cast<T const *>(payload);
+		}
+
+		// decode every packet onto ctx, backends pass their concrete type
+		template <class Context = render_context
+		> void execute(Context * ctx, size_t first = 0, size_t last = static_cast<size_t>(-1)) const;
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		void set_alpha_state(alpha_state const & value) { write(command_type_set_alpha_state, value); }
+
+		void set_blend_state(blend_state const & value) { write(command_type_set_blend_state, value); }
+
+		void set_clear_color(color const & value) { write(command_type_set_clear_color, value); }
+
+		void set_cull_state(cull_state const & value) { write(command_type_set_cull_state, value); }
+
+		void set_depth_state(depth_state const & value) { write(command_type_set_depth_state, value); }
+
+		void set_stencil_state(stencil_state const & value) { write(command_type_set_stencil_state, value); }
+
+		void set_viewport(int_rect const & value) { write(command_type_set_viewport, (vec4i const &)value); } // rect isn't trivially copyable
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		void clear(uint32 mask) { write(command_type_clear, mask); }
+
+		template <class Value
+		> void draw(Value && value) { write(command_type_draw, address<vertexarray>(ML_forward(value))); }
+
+		void draw_arrays(uint32 prim, size_t first, size_t count) { write(command_type_draw_arrays, command_draw_arrays{ prim, first, count }); }
+
+		void draw_indexed(uint32 prim, size_t count) { write(command_type_draw_indexed, command_draw_indexed{ prim, count }); }
+
+		template <class Value
+		> void draw_instanced(Value && value, size_t instances, size_t first_instance = 0) { write(command_type_draw_instanced, command_draw_instanced{ address<vertexarray>(ML_forward(value)), instances, first_instance }); }
+
+		void draw_arrays_instanced(uint32 prim, size_t first, size_t count, size_t instances, size_t first_instance = 0) { write(command_type_draw_arrays_instanced, command_draw_arrays_instanced{ prim, first, count, instances, first_instance }); }
+
+		void draw_indexed_instanced(uint32 prim, size_t count, size_t instances, size_t first_instance = 0) { write(command_type_draw_indexed_instanced, command_draw_indexed_instanced{ prim, count, instances, first_instance }); }
+
+		template <class Value
+		> void draw_indexed_indirect(uint32 prim, Value && buffer, size_t offset, size_t count) { write(command_type_draw_indexed_indirect, command_draw_indexed_indirect{ prim, address<streambuffer>(ML_forward(buffer)), offset, count }); }
+
+		void flush() { write(command_type_flush); }
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		void dispatch(uint32 x, uint32 y = 1, uint32 z = 1) { write(command_type_dispatch, command_dispatch{ x, y, z }); }
+
+		template <class Value
+		> void dispatch_indirect(Value && buffer, size_t offset = 0) { write(command_type_dispatch_indirect, command_dispatch_indirect{ address<storagebuffer>(ML_forward(buffer)), offset }); }
+
+		void memory_barrier(uint32 mask = barrier_flags_all) { write(command_type_memory_barrier, mask); }
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		template <class Value
+		> void bind_vertexarray(Value && value) { write(command_type_bind_vertexarray, address<vertexarray>(ML_forward(value))); }
+
+		template <class Value
+		> void bind_vertexbuffer(Value && value) { write(command_type_bind_vertexbuffer, address<vertexbuffer>(ML_forward(value))); }
+
+		template <class Value
+		> void bind_indexbuffer(Value && value) { write(command_type_bind_indexbuffer, address<indexbuffer>(ML_forward(value))); }
+
+		template <class Value
+		> void bind_texture(Value && value, uint32 slot = 0) { write(command_type_bind_texture, command_bind_texture{ address<texture>(ML_forward(value)), slot }); }
+
+		template <class Value
+		> void bind_image(Value && value, uint32 unit, uint32 access = image_access_read_write, uint32 level = 0) { write(command_type_bind_image, command_bind_image{ address<texture>(ML_forward(value)), unit, access, level }); }
+
+		template <class Value
+		> void bind_uniformbuffer(Value && value, uint32 binding, size_t offset = 0, size_t size = 0) { write(command_type_bind_uniformbuffer, command_bind_uniformbuffer{ address<uniformbuffer>(ML_forward(value)), binding, offset, size }); }
+
+		template <class Value
+		> void bind_streambuffer(Value && value, uint32 binding, size_t offset, size_t size) { write(command_type_bind_streambuffer, command_bind_streambuffer{ address<streambuffer>(ML_forward(value)), binding, offset, size }); }
+
+		template <class Value
+		> void bind_storagebuffer(Value && value, uint32 binding, size_t offset = 0, size_t size = 0) { write(command_type_bind_storagebuffer, command_bind_storagebuffer{ address<storagebuffer>(ML_forward(value)), binding, offset, size }); }
+
+		template <class Value
+		> void bind_framebuffer(Value && value) { write(command_type_bind_framebuffer, address<framebuffer>(ML_forward(value))); }
+
+		template <class Value
+		> void bind_program(Value && value) { write(command_type_bind_program, address<program>(ML_forward(value))); }
+
+		template <class Value
+		> void bind_shader(Value && value) { write(command_type_bind_shader, address<shader>(ML_forward(value))); }
+
+		template <class Value
+		> void bind_pipeline_state(Value && value) { write(command_type_bind_pipeline_state, address<pipeline_state>(ML_forward(value))); }
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		template <class T
+		> void upload(uniform_id loc, T const & value)
+		{
+			if constexpr (std::is_same_v<T, bool>) { write(command_type_upload_bool, command_upload<T>{ loc, value }); }
+			else if constexpr (std::is_same_v<T, int32>) { write(command_type_upload_int, command_upload<T>{ loc, value }); }
+			else if constexpr (std::is_same_v<T, float32>) { write(command_type_upload_float, command_upload<T>{ loc, value }); }
+			else if constexpr (std::is_same_v<T, vec2f>) { write(command_type_upload_vec2, command_upload<T>{ loc, value }); }
+			else if constexpr (std::is_same_v<T, vec3f>) { write(command_type_upload_vec3, command_upload<T>{ loc, value }); }
+			else if constexpr (std::is_same_v<T, vec4f>) { write(command_type_upload_vec4, command_upload<T>{ loc, value }); }
+			else if constexpr (std::is_same_v<T, mat2f>) { write(command_type_upload_mat2, command_upload<T>{ loc, value }); }
+			else if constexpr (std::is_same_v<T, mat3f>) { write(command_type_upload_mat3, command_upload<T>{ loc, value }); }
+			else if constexpr (std::is_same_v<T, mat4f>) { write(command_type_upload_mat4, command_upload<T>{ loc, value }); }
+			else { static_assert(std::is_same_v<T, void>, "unsupported uniform type"); }
+		}
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		// escape hatch for anything without a packet, allocates like any std::function
+		template <class Fn
+		> void push(Fn && fn)
+		{
+			write(command_type_callback, m_callbacks.size());
+
+			m_callbacks.emplace_back(ML_forward(fn));
+		}
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	private:
+		template <class T, class Value
+		> ML_NODISCARD T const * address(Value && value)
+		{
+			if constexpr (std::is_scalar_v<std::decay_t<Value>>)
+			{
+				return static_cast<T const *>(value);
+			}
+			else
+			{
+				// a queued frame may outlive the caller's last reference
+				if constexpr (std::is_convertible_v<std::decay_t<Value> const &, ref<void const>>)
+				{
+					if (value) { m_refs.emplace_back(value); }
+				}
+				return static_cast<T const *>(value.get());
+			}
+		}
+
+		void write(uint32 type)
+		{
+			size_t const offset{ m_data.size() };
+			m_data.resize(offset + 1);
+			*reinterpret_cast<command_header *>(m_data.data() + offset) = { type, 1 };
+			++m_count;
+		}
+
+		template <class T
+		> void write(uint32 type, T const & value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "packets must be trivially copyable");
+			static_assert(alignof(T) <= alignof(uint64), "packet alignment too large");
+
+			size_t const words{ 1 + (sizeof(T) + sizeof(uint64) - 1) / sizeof(uint64) };
+			size_t const offset{ m_data.size() };
+			m_data.resize(offset + words);
+
+			uint64 * const ptr{ m_data.data() + offset };
+			*reinterpret_cast<command_header *>(ptr) = { type, (uint32)words };
+			std::memcpy(ptr + 1, &value, sizeof(T));
+			++m_count;
+		}
+
+		list<uint64>	m_data		; // packet storage
+		list<command>	m_callbacks	; // escape hatch
+		list<ref<void const>>	m_refs	; // objects recorded by shared reference
+		size_t			m_count		; // packet count
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+	};
+}
+
+// EXECUTE
+namespace ml::gfx
+{
+	template <class Context
+	> void command_buffer::execute(Context * ctx, size_t first, size_t last) const
+	{
+		ML_assert(ctx);
+
+		for_each([ctx, this](command_header const & h, void const * p)
+		{
+			switch (h.type)
+			{
+			case command_type_callback: { if (auto const & fn{ get_callback(read<size_t>(p)) }) { fn(ctx); } } break;
+
+			case command_type_set_alpha_state	: ctx->set_alpha_state(read<alpha_state>(p)); break;
+			case command_type_set_blend_state	: ctx->set_blend_state(read<blend_state>(p)); break;
+			case command_type_set_clear_color	: ctx->set_clear_color(read<color>(p)); break;
+			case command_type_set_cull_state	: ctx->set_cull_state(read<cull_state>(p)); break;
+			case command_type_set_depth_state	: ctx->set_depth_state(read<depth_state>(p)); break;
+			case command_type_set_stencil_state	: ctx->set_stencil_state(read<stencil_state>(p)); break;
+			case command_type_set_viewport		: ctx->set_viewport(int_rect{ read<vec4i>(p) }); break;
+
+			case command_type_clear			: ctx->clear(read<uint32>(p)); break;
+			case command_type_draw			: ctx->draw(read<vertexarray const *>(p)); break;
+			case command_type_draw_arrays	: { auto const & c{ read<command_draw_arrays>(p) }; ctx->draw_arrays(c.prim, c.first, c.count); } break;
+			case command_type_draw_indexed	: { auto const & c{ read<command_draw_indexed>(p) }; ctx->draw_indexed(c.prim, c.count); } break;
+			case command_type_draw_instanced			: { auto const & c{ read<command_draw_instanced>(p) }; ctx->draw_instanced(c.value, c.instances, c.first_instance); } break;
+			case command_type_draw_arrays_instanced		: { auto const & c{ read<command_draw_arrays_instanced>(p) }; ctx->draw_arrays_instanced(c.prim, c.first, c.count, c.instances, c.first_instance); } break;
+			case command_type_draw_indexed_instanced	: { auto const & c{ read<command_draw_indexed_instanced>(p) }; ctx->draw_indexed_instanced(c.prim, c.count, c.instances, c.first_instance); } break;
+			case command_type_draw_indexed_indirect		: { auto const & c{ read<command_draw_indexed_indirect>(p) }; ctx->draw_indexed_indirect(c.prim, c.buffer, c.offset, c.count); } break;
+			case command_type_flush			: ctx->flush(); break;
+
+			case command_type_dispatch			: { auto const & c{ read<command_dispatch>(p) }; ctx->dispatch(c.x, c.y, c.z); } break;
+			case command_type_dispatch_indirect	: { auto const & c{ read<command_dispatch_indirect>(p) }; ctx->dispatch_indirect(c.buffer, c.offset); } break;
+			case command_type_memory_barrier	: ctx->memory_barrier(read<uint32>(p)); break;
+
+			case command_type_bind_vertexarray	: ctx->bind_vertexarray(read<vertexarray const *>(p)); break;
+			case command_type_bind_vertexbuffer	: ctx->bind_vertexbuffer(read<vertexbuffer const *>(p)); break;
+			case command_type_bind_indexbuffer	: ctx->bind_indexbuffer(read<indexbuffer const *>(p)); break;
+			case command_type_bind_texture		: { auto const & c{ read<command_bind_texture>(p) }; ctx->bind_texture(c.value, c.slot); } break;
+			case command_type_bind_image		: { auto const & c{ read<command_bind_image>(p) }; ctx->bind_image(c.value, c.unit, c.access, c.level); } break;
+			case command_type_bind_uniformbuffer: { auto const & c{ read<command_bind_uniformbuffer>(p) }; ctx->bind_uniformbuffer(c.value, c.binding, c.offset, c.size); } break;
+			case command_type_bind_streambuffer	: { auto const & c{ read<command_bind_streambuffer>(p) }; ctx->bind_streambuffer(c.value, c.binding, c.offset, c.size); } break;
+			case command_type_bind_storagebuffer: { auto const & c{ read<command_bind_storagebuffer>(p) }; ctx->bind_storagebuffer(c.value, c.binding, c.offset, c.size); } break;
+			case command_type_bind_framebuffer	: ctx->bind_framebuffer(read<framebuffer const *>(p)); break;
+			case command_type_bind_program		: ctx->bind_program(read<program const *>(p)); break;
+			case command_type_bind_shader		: ctx->bind_shader(read<shader const *>(p)); break;
+			case command_type_bind_pipeline_state	: ctx->bind_pipeline_state(read<pipeline_state const *>(p)); break;
+
+			case command_type_upload_bool	: { auto const & c{ read<command_upload<bool>>(p) }; ctx->upload(c.loc, c.value); } break;
+			case command_type_upload_int	: { auto const & c{ read<command_upload<int32>>(p) }; ctx->upload(c.loc, c.value); } break;
+			case command_type_upload_float	: { auto const & c{ read<command_upload<float32>>(p) }; ctx->upload(c.loc, c.value); } break;
+			case command_type_upload_vec2	: { auto const & c{ read<command_upload<vec2f>>(p) }; ctx->upload(c.loc, c.value); } break;
+			case command_type_upload_vec3	: { auto const & c{ read<command_upload<vec3f>>(p) }; ctx->upload(c.loc, c.value); } break;
+			case command_type_upload_vec4	: { auto const & c{ read<command_upload<vec4f>>(p) }; ctx->upload(c.loc, c.value); } break;
+			case command_type_upload_mat2	: { auto const & c{ read<command_upload<mat2f>>(p) }; ctx->upload(c.loc, c.value); } break;
+			case command_type_upload_mat3	: { auto const & c{ read<command_upload<mat3f>>(p) }; ctx->upload(c.loc, c.value); } break;
+			case command_type_upload_mat4	: { auto const & c{ read<command_upload<mat4f>>(p) }; ctx->upload(c.loc, c.value); } break;
+			}
+		}
+		, first, last);
+	}
+}
+
+#endif // !_ML_COMMAND_BUFFER_HPP_
\ No newline at end of file
@@ -0,0 +1,58 @@
+#include <modus_core/graphics/DrawQueue.hpp>
+
+namespace ml::gfx
+{
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	void draw_queue::sort()
+	{
+		m_sorted = true;
+
+		size_t const count{ m_keys.size() };
+		if (count < 2) { return; }
+
+		// byte histograms for all eight passes in one sweep
+		uint32 histogram[8][256]{};
+		for (sort_entry const & e : m_keys)
+		{
+			for (size_t pass = 0; pass < 8; ++pass)
+			{
+				++histogram[pass][(e.key >> (pass * 8)) & 0xff];
+			}
+		}
+
+		m_scratch.resize(count);
+		sort_entry * src{ m_keys.data() }, * dst{ m_scratch.data() };
+
+		// least significant digit first, which keeps the sort stable
+		for (size_t pass = 0; pass < 8; ++pass)
+		{
+			uint32 * const h{ histogram[pass] };
+
+			// every key shares this byte, nothing to move
+			if (h[(src[0].key >> (pass * 8)) & 0xff] == count) { continue; }
+
+			uint32 offset{};
+			for (size_t i = 0; i < 256; ++i)
+			{
+				uint32 const n{ h[i] };
+				h[i] = offset;
+				offset += n;
+			}
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				dst[h[(src[i].key >> (pass * 8)) & 0xff]++] = src[i];
+			}
+
+			std::swap(src, dst);
+		}
+
+		if (src != m_keys.data())
+		{
+			std::copy(src, src + count, m_keys.data());
+		}
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+}
\ No newline at end of file
@@ -0,0 +1,220 @@
+#ifndef _ML_DRAW_QUEUE_HPP_
+#define _ML_DRAW_QUEUE_HPP_
+
+#include <modus_core/graphics/CommandBuffer.hpp>
+
+// DRAW KEY
+namespace ml::gfx
+{
+	// 64 bit sort key, most significant first
+	// layer(4) | pass(4) | program(12) | material(20) | depth(24)
+	struct ML_NODISCARD draw_key final
+	{
+		enum : uint32
+		{
+			depth_bits		= 24,
+			material_bits	= 20,
+			program_bits	= 12,
+			pass_bits		= 4,
+			layer_bits		= 4,
+
+			depth_shift		= 0,
+			material_shift	= depth_shift + depth_bits,
+			program_shift	= material_shift + material_bits,
+			pass_shift		= program_shift + program_bits,
+			layer_shift		= pass_shift + pass_bits,
+		};
+
+		ML_NODISCARD static constexpr uint64 mask(uint32 bits) noexcept
+		{
+			return (1ull << bits) - 1ull;
+		}
+
+		ML_NODISCARD static constexpr uint64 make(uint32 layer, uint32 pass, uint32 program, uint32 material, uint32 depth) noexcept
+		{
+			return
+				((layer		& mask(layer_bits))		<< layer_shift)		|
+				((pass		& mask(pass_bits))		<< pass_shift)		|
+				((program	& mask(program_bits))	<< program_shift)	|
+				((material	& mask(material_bits))	<< material_shift)	|
+				((depth		& mask(depth_bits))		<< depth_shift);
+		}
+
+		// fold an object address into an id of the given width
+		ML_NODISCARD static uint32 fold(void const * value, uint32 bits) noexcept
+		{
+			uint64 x{ (uint64)(intptr_t)value };
+			x ^= x >> 33; x *= 0xff51afd7ed558ccdull; x ^= x >> 33;
+			return (uint32)(x & mask(bits));
+		}
+
+		// quantize view depth in [znear, zfar], translucent geometry sorts back to front
+		ML_NODISCARD static uint32 quantize_depth(float32 depth, float32 znear, float32 zfar, bool back_to_front = false) noexcept
+		{
+			float32 const t{ std::clamp((depth - znear) / (zfar - znear), 0.f, 1.f) };
+			uint32 const d{ (uint32)(t * (float32)mask(depth_bits)) };
+			return back_to_front ? ((uint32)mask(depth_bits) - d) : d;
+		}
+	};
+}
+
+// DRAW ITEM
+namespace ml::gfx
+{
+	// single draw, count of zero draws the whole vertexarray
+	struct ML_NODISCARD draw_item final
+	{
+		static constexpr size_t max_textures{ 8 };
+
+		program const *		pgm			; // program
+		vertexarray const *	vao			; // vertexarray
+		texture const *		textures[max_textures]; // textures, bound to slots in order
+		uint32				prim		; // primitive
+		uint32				first		; // first vertex, ignored when indexed
+		uint32				count		; // vertex / index count
+		bool				indexed		; // draw elements
+		uint32				data_first	; // per draw uniform packets
+		uint32				data_last	; //
+	};
+}
+
+// DRAW QUEUE
+namespace ml::gfx
+{
+	// records draws with a sort key and issues them in key order,
+	// skipping binds that would not change anything
+	struct ML_CORE_API draw_queue final
+	{
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		using allocator_type = typename pmr::polymorphic_allocator<byte>;
+
+		struct ML_NODISCARD sort_entry final
+		{
+			uint64 key; uint32 index;
+		};
+
+		draw_queue(allocator_type alloc = {}) noexcept
+			: m_items	{ alloc }
+			, m_keys	{ alloc }
+			, m_scratch	{ alloc }
+			, m_data	{ alloc }
+			, m_sorted	{}
+		{
+		}
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		void clear() noexcept
+		{
+			m_items.clear();
+			m_keys.clear();
+			m_data.clear();
+			m_sorted = false;
+		}
+
+		ML_NODISCARD bool empty() const noexcept { return m_items.empty(); }
+
+		ML_NODISCARD auto size() const noexcept -> size_t { return m_items.size(); }
+
+		ML_NODISCARD auto get_items() const noexcept -> list<draw_item> const & { return m_items; }
+
+		ML_NODISCARD auto get_keys() const noexcept -> list<sort_entry> const & { return m_keys; }
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		// record a draw, uniforms uploaded afterwards belong to it
+		draw_item & push(uint64 key, program const * pgm, vertexarray const * vao, uint32 prim = primitive_triangles, uint32 first = 0, uint32 count = 0, bool indexed = false)
+		{
+			uint32 const offset{ (uint32)m_data.get_offset() };
+
+			m_keys.push_back({ key, (uint32)m_items.size() });
+
+			m_sorted = false;
+
+			return m_items.emplace_back(draw_item{ pgm, vao, {}, prim, first, count, indexed, offset, offset });
+		}
+
+		template <class T
+		> void upload(uniform_id loc, T const & value)
+		{
+			ML_assert(!m_items.empty());
+
+			m_data.upload(loc, value);
+
+			m_items.back().data_last = (uint32)m_data.get_offset();
+		}
+
+		// sort keys, stable, so equal keys keep recording order
+		void sort();
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		template <class Context = render_context
+		> void execute(Context * ctx)
+		{
+			ML_assert(ctx);
+
+			if (!m_sorted) { sort(); }
+
+			program const * bound_program{};
+			vertexarray const * bound_vertices{};
+			texture const * bound_textures[draw_item::max_textures]{};
+
+			for (sort_entry const & e : m_keys)
+			{
+				draw_item const & item{ m_items[e.index] };
+
+				if (item.pgm != bound_program)
+				{
+					ctx->bind_program(bound_program = item.pgm);
+				}
+
+				for (uint32 i = 0; i < draw_item::max_textures; ++i)
+				{
+					if (item.textures[i] && item.textures[i] != bound_textures[i])
+					{
+						ctx->bind_texture(bound_textures[i] = item.textures[i], i);
+					}
+				}
+
+				if (item.data_first != item.data_last)
+				{
+					m_data.execute(ctx, item.data_first, item.data_last);
+				}
+
+				if (!item.count)
+				{
+					// draw binds its own buffers
+					ctx->draw(item.vao);
+
+					bound_vertices = item.vao;
+				}
+				else
+				{
+					if (item.vao != bound_vertices)
+					{
+						ctx->bind_vertexarray(bound_vertices = item.vao);
+					}
+
+					if (item.indexed) { ctx->draw_indexed(item.prim, item.count); }
+
+					else { ctx->draw_arrays(item.prim, item.first, item.count); }
+				}
+			}
+		}
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	private:
+		list<draw_item>		m_items		; // draws in recording order
+		list<sort_entry>	m_keys		; // sort keys
+		list<sort_entry>	m_scratch	; // radix sort scratch
+		command_buffer		m_data		; // per draw uniforms
+		bool				m_sorted	; // keys are sorted
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+	};
+}
+
+#endif // !_ML_DRAW_QUEUE_HPP_
\ No newline at end of file
@@ -0,0 +1,103 @@
+#include <modus_core/graphics/FrameSync.hpp>
+
+namespace ml
+{
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	frame_sync::frame_sync(size_t frames_in_flight) noexcept
+		: m_context			{}
+		, m_frames			{}
+		, m_frames_in_flight{}
+		, m_index			{}
+		, m_cpu_wait		{}
+		, m_gpu_time		{}
+	{
+		set_frames_in_flight(frames_in_flight);
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	void frame_sync::set_frames_in_flight(size_t value) noexcept
+	{
+		m_frames_in_flight = (std::min)(value, (size_t)max_frames_in_flight);
+	}
+
+	void frame_sync::reset()
+	{
+		if (!m_context) { return; }
+
+		for (frame & f : m_frames)
+		{
+			m_context->delete_fence(f.fence);
+			m_context->delete_query(f.begin);
+			m_context->delete_query(f.end);
+			f = {};
+		}
+
+		m_context = nullptr;
+		m_index = 0;
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	void frame_sync::begin_frame(gfx::render_context * ctx)
+	{
+		ML_assert(ctx);
+
+		if (m_context != ctx) { reset(); m_context = ctx; }
+
+		frame & f{ m_frames[m_index] };
+
+		// the slot was last used frames_in_flight frames ago
+		if (f.fence)
+		{
+			timer const t{ true };
+			if (m_frames_in_flight)
+			{
+				while (!ctx->wait_fence(f.fence, 1'000'000)) {}
+			}
+			m_cpu_wait.store(t.elapsed().count(), std::memory_order_relaxed);
+
+			resolve(f);
+		}
+		else
+		{
+			m_cpu_wait.store(0.f, std::memory_order_relaxed);
+		}
+
+		if (!f.begin) { f.begin = ctx->new_query(); }
+		if (!f.end) { f.end = ctx->new_query(); }
+
+		ctx->query_timestamp(f.begin);
+	}
+
+	void frame_sync::end_frame(gfx::render_context * ctx)
+	{
+		ML_assert(ctx && ctx == m_context);
+
+		frame & f{ m_frames[m_index] };
+
+		ctx->query_timestamp(f.end);
+
+		f.fence = ctx->insert_fence();
+
+		m_index = (m_index + 1) % (m_frames_in_flight ? m_frames_in_flight : (size_t)max_frames_in_flight);
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	void frame_sync::resolve(frame & f)
+	{
+		// results are only read once available so unlimited mode never stalls on them
+		uint64 begin{}, end{};
+		if (m_context->get_query_result(f.begin, begin) && m_context->get_query_result(f.end, end) && begin <= end)
+		{
+			m_gpu_time.store((float32)(end - begin) * 1e-9f, std::memory_order_relaxed);
+		}
+
+		m_context->delete_fence(f.fence);
+		f.fence = nullptr;
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+#ifndef _ML_FRAME_SYNC_HPP_
+#define _ML_FRAME_SYNC_HPP_
+
+#include <modus_core/detail/Timer.hpp>
+#include <modus_core/graphics/RenderAPI.hpp>
+
+#include <atomic>
+
+// FRAME SYNC
+namespace ml
+{
+	// limits how many frames the cpu may queue ahead of the gpu,
+	// each frame is fenced and bracketed by timestamps to measure it
+	struct ML_CORE_API frame_sync final : non_copyable
+	{
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		// streambuffers keep three regions by default, which covers the deepest setting
+		enum : size_t { max_frames_in_flight = 3 };
+
+		struct ML_NODISCARD frame final
+		{
+			gfx::sync_id	fence	; // signals when the frame is done
+			gfx::query_id	begin	; // gpu clock at frame start
+			gfx::query_id	end		; // gpu clock at frame end
+		};
+
+		explicit frame_sync(size_t frames_in_flight = 2) noexcept;
+
+		~frame_sync() noexcept { reset(); }
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		// zero disables waiting, timings are still recorded
+		void set_frames_in_flight(size_t value) noexcept;
+
+		// release fences and queries, the context must be current
+		void reset();
+
+		// wait until the frame which last used this slot has completed
+		void begin_frame(gfx::render_context * ctx);
+
+		// fence everything issued this frame, call after swapping buffers
+		void end_frame(gfx::render_context * ctx);
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		ML_NODISCARD auto get_frames_in_flight() const noexcept -> size_t { return m_frames_in_flight; }
+
+		// time the cpu spent blocked on the gpu at the start of the last frame, safe from any thread
+		ML_NODISCARD auto get_cpu_wait() const noexcept -> duration { return duration{ m_cpu_wait.load(std::memory_order_relaxed) }; }
+
+		// gpu time of the most recently completed frame, safe from any thread
+		ML_NODISCARD auto get_gpu_time() const noexcept -> duration { return duration{ m_gpu_time.load(std::memory_order_relaxed) }; }
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	private:
+		void resolve(frame & f);
+
+		gfx::render_context *		m_context			; // context owning the handles
+		frame						m_frames[max_frames_in_flight]; // frame slots
+		size_t						m_frames_in_flight	; // frames the cpu may run ahead
+		size_t						m_index				; // current slot
+		std::atomic<float32>		m_cpu_wait			; // last cpu wait, in seconds
+		std::atomic<float32>		m_gpu_time			; // last gpu frame time, in seconds
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+	};
+}
+
+#endif // !_ML_FRAME_SYNC_HPP_
\ No newline at end of file
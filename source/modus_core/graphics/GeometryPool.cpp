@@ -0,0 +1,194 @@
+#include <modus_core/graphics/GeometryPool.hpp>
+
+#include <numeric>
+
+namespace ml
+{
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	static ref<gfx::streambuffer> _make_command_stream(size_t capacity) noexcept
+	{
+		return gfx::streambuffer::create(gfx::spec<gfx::streambuffer>{ capacity * sizeof(gfx::draw_indirect_command) });
+	}
+
+	geometry_pool::geometry_pool(gfx::buffer_layout const & layout, size_t vertex_capacity, size_t index_capacity, size_t draw_capacity, allocator_type alloc)
+		: m_layout			{ layout }
+		, m_vao				{}
+		, m_vertices		{}
+		, m_indices			{}
+		, m_commands		{ _make_command_stream((std::max)(draw_capacity, (size_t)1)) }
+		, m_draw_capacity	{ (std::max)(draw_capacity, (size_t)1) }
+		, m_geometry		{ alloc }
+		, m_free_handles	{ alloc }
+		, m_free_vertices	{ alloc }
+		, m_free_indices	{ alloc }
+		, m_draws			{ alloc }
+	{
+		grow((std::max)(vertex_capacity, (size_t)1), (std::max)(index_capacity, (size_t)1));
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	uint32 geometry_pool::add(list<float32> const & vertices, list<uint32> const & indices)
+	{
+		size_t const floats_per_vertex{ m_layout.stride() / sizeof(float32) };
+		if (!floats_per_vertex) { return invalid_handle; }
+
+		uint32 const vertex_count{ (uint32)(vertices.size() / floats_per_vertex) };
+		if (!vertex_count) { return invalid_handle; }
+
+		// unindexed meshes draw their vertices in order
+		list<uint32> sequential{};
+		if (indices.empty())
+		{
+			sequential.resize(vertex_count);
+			std::iota(sequential.begin(), sequential.end(), 0u);
+		}
+		list<uint32> const & index_data{ indices.empty() ? sequential : indices };
+		uint32 const index_count{ (uint32)index_data.size() };
+
+		geometry g{};
+		while (!allocate(m_free_vertices, vertex_count, g.first_vertex))
+		{
+			grow(m_vertices->get_count() / floats_per_vertex * 2, m_indices->get_count());
+		}
+		while (!allocate(m_free_indices, index_count, g.first_index))
+		{
+			grow(m_vertices->get_count() / floats_per_vertex, m_indices->get_count() * 2);
+		}
+		g.vertex_count = vertex_count;
+		g.index_count = index_count;
+
+		m_vertices->set_data(vertex_count * floats_per_vertex, vertices.data(), (size_t)g.first_vertex * m_layout.stride());
+
+		m_indices->set_data(index_count, index_data.data(), (size_t)g.first_index * sizeof(uint32));
+
+		if (!m_free_handles.empty())
+		{
+			uint32 const handle{ m_free_handles.back() };
+			m_free_handles.pop_back();
+			m_geometry[handle] = g;
+			return handle;
+		}
+		m_geometry.push_back(g);
+		return (uint32)m_geometry.size() - 1;
+	}
+
+	void geometry_pool::remove(uint32 handle)
+	{
+		if (!contains(handle)) { return; }
+
+		geometry & g{ m_geometry[handle] };
+
+		release(m_free_vertices, { g.first_vertex, g.vertex_count });
+
+		release(m_free_indices, { g.first_index, g.index_count });
+
+		g = {};
+
+		m_free_handles.push_back(handle);
+	}
+
+	void geometry_pool::clear()
+	{
+		m_commands->next_frame();
+
+		m_draws.clear();
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	bool geometry_pool::allocate(list<span> & free_list, uint32 count, uint32 & first)
+	{
+		// first fit, spans are kept sorted and merged
+		for (auto it{ free_list.begin() }; it != free_list.end(); ++it)
+		{
+			if (it->count < count) { continue; }
+
+			first = it->first;
+
+			if (it->count == count) { free_list.erase(it); }
+			else { it->first += count; it->count -= count; }
+
+			return true;
+		}
+		return false;
+	}
+
+	void geometry_pool::release(list<span> & free_list, span value)
+	{
+		if (!value.count) { return; }
+
+		auto it{ std::lower_bound(free_list.begin(), free_list.end(), value, [](span const & a, span const & b) noexcept
+		{
+			return a.first < b.first;
+		}) };
+
+		it = free_list.insert(it, value);
+
+		// merge with the following span
+		if (auto next{ std::next(it) }; next != free_list.end() && it->first + it->count == next->first)
+		{
+			it->count += next->count;
+			free_list.erase(next);
+		}
+
+		// merge with the preceding span
+		if (it != free_list.begin())
+		{
+			if (auto prev{ std::prev(it) }; prev->first + prev->count == it->first)
+			{
+				prev->count += it->count;
+				free_list.erase(it);
+			}
+		}
+	}
+
+	void geometry_pool::grow(size_t vertex_capacity, size_t index_capacity)
+	{
+		size_t const floats_per_vertex{ m_layout.stride() / sizeof(float32) };
+
+		size_t const old_vertices{ m_vertices ? m_vertices->get_count() / floats_per_vertex : 0 };
+
+		size_t const old_indices{ m_indices ? m_indices->get_count() : 0 };
+
+		// new stores start with the old contents, the tail becomes free
+		list<float32> vertex_data(vertex_capacity * floats_per_vertex, 0.f);
+		if (m_vertices) { std::memcpy(vertex_data.data(), m_vertices->get_buffer().data(), m_vertices->get_size()); }
+
+		list<uint32> index_data(index_capacity, 0u);
+		if (m_indices) { std::memcpy(index_data.data(), m_indices->get_buffer().data(), m_indices->get_size()); }
+
+		m_vertices = gfx::vertexbuffer::create({ gfx::usage_dynamic, vertex_data.size(), vertex_data.data() });
+
+		m_indices = gfx::indexbuffer::create({ gfx::usage_dynamic, index_data.size(), index_data.data() });
+
+		m_vao = gfx::vertexarray::create({ gfx::primitive_triangles });
+		m_vao->set_layout(m_layout);
+		m_vao->add_vertices(m_vertices);
+		m_vao->set_indices(m_indices);
+
+		release(m_free_vertices, { (uint32)old_vertices, (uint32)(vertex_capacity - old_vertices) });
+
+		release(m_free_indices, { (uint32)old_indices, (uint32)(index_capacity - old_indices) });
+	}
+
+	gfx::stream_range geometry_pool::reserve_commands(size_t size)
+	{
+		gfx::stream_range range{ m_commands->allocate(size, sizeof(uint32)) };
+		if (!range.data)
+		{
+			// grow geometrically, a fresh stream starts at its first region
+			while (m_draw_capacity * sizeof(gfx::draw_indirect_command) < size) { m_draw_capacity *= 2; }
+
+			m_commands = _make_command_stream(m_draw_capacity);
+
+			range = m_commands->allocate(size, sizeof(uint32));
+
+			ML_assert(range.data);
+		}
+		return range;
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+}
\ No newline at end of file
@@ -0,0 +1,127 @@
+#ifndef _ML_GEOMETRY_POOL_HPP_
+#define _ML_GEOMETRY_POOL_HPP_
+
+#include <modus_core/graphics/RenderAPI.hpp>
+#include <modus_core/graphics/Vertex.hpp>
+
+// GEOMETRY POOL
+namespace ml
+{
+	// many meshes of one vertex format sub allocated in shared vertex and index buffers,
+	// drawn through one vertexarray with a single multi draw indirect per frame
+	struct ML_CORE_API geometry_pool final : non_copyable
+	{
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		using allocator_type = typename pmr::polymorphic_allocator<byte>;
+
+		enum : uint32 { invalid_handle = static_cast<uint32>(-1) };
+
+		// where a mesh lives in the shared buffers
+		struct ML_NODISCARD geometry final
+		{
+			uint32 first_vertex	; // first vertex
+			uint32 vertex_count	; // vertex count
+			uint32 first_index	; // first index
+			uint32 index_count	; // index count
+		};
+
+		// free span, in vertices or indices
+		struct ML_NODISCARD span final
+		{
+			uint32 first, count;
+		};
+
+		geometry_pool(gfx::buffer_layout const & layout = {}, size_t vertex_capacity = 65536, size_t index_capacity = 196608, size_t draw_capacity = 4096, allocator_type alloc = {});
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		// upload a mesh, no indices draws the vertices in order
+		ML_NODISCARD uint32 add(list<float32> const & vertices, list<uint32> const & indices = {});
+
+		ML_NODISCARD uint32 add(list<vertex> const & vertices, list<uint32> const & indices = {})
+		{
+			return add(util::contiguous(vertices), indices);
+		}
+
+		void remove(uint32 handle);
+
+		ML_NODISCARD bool contains(uint32 handle) const noexcept
+		{
+			return handle < m_geometry.size() && m_geometry[handle].index_count;
+		}
+
+		ML_NODISCARD auto get_geometry(uint32 handle) const noexcept -> geometry const & { return m_geometry[handle]; }
+
+		ML_NODISCARD auto get_vertexarray() const noexcept -> ref<gfx::vertexarray> const & { return m_vao; }
+
+		ML_NODISCARD auto get_layout() const noexcept -> gfx::buffer_layout const & { return m_layout; }
+
+		ML_NODISCARD auto get_draws() const noexcept -> list<gfx::draw_indirect_command> const & { return m_draws; }
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		// start a new frame, the command stream moves on to its next region
+		void clear();
+
+		// queue a draw of a pooled mesh
+		void push(uint32 handle, uint32 instance_count = 1, uint32 base_instance = 0)
+		{
+			ML_assert(contains(handle));
+
+			geometry const & g{ m_geometry[handle] };
+
+			m_draws.push_back({ g.index_count, instance_count, g.first_index, (int32)g.first_vertex, base_instance });
+		}
+
+		// write queued draws into the command stream and issue them in one call
+		template <class Context = gfx::render_context
+		> void execute(Context * ctx, uint32 prim = gfx::primitive_triangles)
+		{
+			ML_assert(ctx);
+
+			if (m_draws.empty()) { return; }
+
+			size_t const size{ m_draws.size() * sizeof(gfx::draw_indirect_command) };
+
+			gfx::stream_range const range{ reserve_commands(size) };
+
+			std::memcpy(range.data, m_draws.data(), size);
+
+			ctx->bind_vertexarray(m_vao.get());
+
+			ctx->draw_indexed_indirect(prim, m_commands.get(), range.offset, m_draws.size());
+
+			m_draws.clear();
+		}
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	private:
+		ML_NODISCARD static bool allocate(list<span> & free_list, uint32 count, uint32 & first);
+
+		static void release(list<span> & free_list, span value);
+
+		void grow(size_t vertex_capacity, size_t index_capacity);
+
+		ML_NODISCARD gfx::stream_range reserve_commands(size_t size);
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		gfx::buffer_layout						m_layout		; // vertex format
+		ref<gfx::vertexarray>					m_vao			; // shared vertexarray
+		ref<gfx::vertexbuffer>					m_vertices		; // shared vertices
+		ref<gfx::indexbuffer>					m_indices		; // shared indices
+		ref<gfx::streambuffer>					m_commands		; // indirect commands
+		size_t									m_draw_capacity	; // commands per frame
+		list<geometry>							m_geometry		; // meshes by handle
+		list<uint32>							m_free_handles	; // reusable handles
+		list<span>								m_free_vertices	; // free vertex spans
+		list<span>								m_free_indices	; // free index spans
+		list<gfx::draw_indirect_command>		m_draws			; // queued draws
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+	};
+}
+
+#endif // !_ML_GEOMETRY_POOL_HPP_
\ No newline at end of file
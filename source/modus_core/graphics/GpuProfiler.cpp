@@ -0,0 +1,191 @@
+#include <modus_core/graphics/GpuProfiler.hpp>
+
+#include <fstream>
+
+namespace ml
+{
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	gpu_profiler::gpu_profiler()
+		: m_storage			{ pmr::new_delete_resource() }
+		, m_context			{}
+		, m_frames			{ list<marker>{ &m_storage }, list<marker>{ &m_storage }, list<marker>{ &m_storage }, list<marker>{ &m_storage } }
+		, m_indices			{}
+		, m_slot			{}
+		, m_stack			{ &m_storage }
+		, m_pool			{ &m_storage }
+		, m_results			{ &m_storage }
+		, m_capture			{ &m_storage }
+		, m_capture_frames	{}
+		, m_enabled			{ true }
+		, m_mutex			{}
+	{
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	void gpu_profiler::reset()
+	{
+		if (!m_context) { return; }
+
+		for (list<marker> & frame : m_frames)
+		{
+			for (marker const & m : frame)
+			{
+				m_context->delete_query(m.begin);
+				m_context->delete_query(m.end);
+			}
+			frame.clear();
+		}
+
+		for (gfx::query_id e : m_pool) { m_context->delete_query(e); }
+		m_pool.clear();
+
+		m_stack.clear();
+		m_context = nullptr;
+	}
+
+	void gpu_profiler::begin_frame(gfx::render_context * ctx, uint64 index)
+	{
+		ML_assert(ctx);
+
+		if (m_context != ctx) { reset(); m_context = ctx; }
+
+		// the slot we move into was recorded frame_latency frames ago
+		m_slot = (m_slot + 1) % frame_latency;
+		collect(m_slot);
+		m_indices[m_slot] = index;
+		m_stack.clear();
+
+		(void)begin(ctx, "frame");
+	}
+
+	void gpu_profiler::end_frame(gfx::render_context * ctx)
+	{
+		while (!m_stack.empty()) { end(ctx); }
+	}
+
+	bool gpu_profiler::begin(gfx::render_context * ctx, cstring name)
+	{
+		if (!is_enabled() || ctx != m_context) { return false; }
+
+		list<marker> & frame{ m_frames[m_slot] };
+
+		m_stack.push_back(frame.size());
+
+		marker & m{ frame.emplace_back(marker{ string{ name ? name : "", &m_storage }, (uint32)m_stack.size() - 1, acquire(), acquire() }) };
+
+		ctx->query_timestamp(m.begin);
+
+		return true;
+	}
+
+	void gpu_profiler::end(gfx::render_context * ctx)
+	{
+		if (m_stack.empty() || ctx != m_context) { return; }
+
+		ctx->query_timestamp(m_frames[m_slot][m_stack.back()].end);
+
+		m_stack.pop_back();
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	void gpu_profiler::start_capture(size_t frame_count)
+	{
+		std::unique_lock<std::mutex> lock{ m_mutex };
+		m_capture.clear();
+		m_capture_frames = frame_count;
+	}
+
+	json gpu_profiler::get_trace() const
+	{
+		std::unique_lock<std::mutex> lock{ m_mutex };
+
+		list<result> const & source{ m_capture.empty() ? m_results : m_capture };
+
+		json events{ json::array() };
+		if (!source.empty())
+		{
+			uint64 const origin{ source.front().begin };
+			for (result const & r : source)
+			{
+				events.push_back({
+					{ "name", r.name },
+					{ "cat", "gpu" },
+					{ "ph", "X" },
+					{ "pid", 0 },
+					{ "tid", 0 },
+					{ "ts", (float64)(r.begin - origin) * 1e-3 },
+					{ "dur", (float64)(r.end - r.begin) * 1e-3 },
+					{ "args", { { "frame", r.frame }, { "depth", r.depth } } },
+				});
+			}
+		}
+		return json{ { "traceEvents", events }, { "displayTimeUnit", "ms" } };
+	}
+
+	bool gpu_profiler::save_trace(fs::path const & path) const
+	{
+		std::ofstream f{ path };
+		if (!f) { return false; }
+		f << get_trace().dump();
+		return true;
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	gfx::query_id gpu_profiler::acquire()
+	{
+		if (m_pool.empty()) { return m_context->new_query(); }
+
+		gfx::query_id const e{ m_pool.back() };
+		m_pool.pop_back();
+		return e;
+	}
+
+	void gpu_profiler::collect(size_t slot)
+	{
+		list<marker> & frame{ m_frames[slot] };
+		if (frame.empty()) { return; }
+
+		// a frame that is somehow still pending is dropped rather than waited on,
+		// everything allocated here comes from our own storage, never the default resource
+		list<result> results{ &m_storage };
+		results.reserve(frame.size());
+		for (marker const & m : frame)
+		{
+			result r{ string{ m.name, &m_storage }, m_indices[slot], m.depth };
+			if (!m_context->get_query_result(m.begin, r.begin) || !m_context->get_query_result(m.end, r.end))
+			{
+				results.clear();
+				break;
+			}
+			if (r.end < r.begin) { r.end = r.begin; }
+			results.push_back(std::move(r));
+		}
+
+		for (marker const & m : frame)
+		{
+			m_pool.push_back(m.begin);
+			m_pool.push_back(m.end);
+		}
+		frame.clear();
+
+		if (results.empty()) { return; }
+
+		// publish the snapshot
+		std::unique_lock<std::mutex> lock{ m_mutex };
+		if (m_capture_frames)
+		{
+			for (result const & r : results)
+			{
+				m_capture.push_back({ string{ r.name, &m_storage }, r.frame, r.depth, r.begin, r.end });
+			}
+			--m_capture_frames;
+		}
+		m_results.swap(results);
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+}
\ No newline at end of file
@@ -0,0 +1,132 @@
+#ifndef _ML_GPU_PROFILER_HPP_
+#define _ML_GPU_PROFILER_HPP_
+
+#include <modus_core/graphics/RenderAPI.hpp>
+
+#include <atomic>
+#include <mutex>
+
+// GPU PROFILER
+namespace ml
+{
+	// nested gpu timings from pooled timestamp queries,
+	// results are read back a few frames late so the cpu never waits on them,
+	// recording may run on a render thread while results are read from another
+	struct ML_CORE_API gpu_profiler final : non_copyable
+	{
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		enum : size_t { frame_latency = 4 };
+
+		// open marker
+		struct ML_NODISCARD marker final
+		{
+			string			name	; // name
+			uint32			depth	; // nesting depth
+			gfx::query_id	begin	; // timestamp at begin
+			gfx::query_id	end		; // timestamp at end
+		};
+
+		// resolved marker, times are gpu nanoseconds
+		struct ML_NODISCARD result final
+		{
+			string			name	; // name
+			uint64			frame	; // frame index
+			uint32			depth	; // nesting depth
+			uint64			begin	; // begin time
+			uint64			end		; // end time
+
+			ML_NODISCARD float64 milliseconds() const noexcept { return (float64)(end - begin) * 1e-6; }
+		};
+
+		// closes a marker when it goes out of scope
+		struct ML_NODISCARD scope final : non_copyable
+		{
+			scope(gpu_profiler * profiler, gfx::render_context * ctx, cstring name)
+				: m_profiler{ profiler }, m_context{ ctx }, m_open{ profiler && profiler->begin(ctx, name) }
+			{
+			}
+
+			~scope() { if (m_open) { m_profiler->end(m_context); } }
+
+		private:
+			gpu_profiler * m_profiler; gfx::render_context * m_context; bool m_open;
+		};
+
+		gpu_profiler();
+
+		~gpu_profiler() noexcept { reset(); }
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		// release every query, the context must be current
+		void reset();
+
+		// collect the oldest frame and open the root marker of a new one
+		void begin_frame(gfx::render_context * ctx, uint64 index);
+
+		// close the root marker
+		void end_frame(gfx::render_context * ctx);
+
+		// false if nothing was opened, the matching end must then be skipped
+		bool begin(gfx::render_context * ctx, cstring name);
+
+		void end(gfx::render_context * ctx);
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		ML_NODISCARD bool is_enabled() const noexcept { return m_enabled.load(std::memory_order_relaxed); }
+
+		void set_enabled(bool value) noexcept { m_enabled.store(value, std::memory_order_relaxed); }
+
+		// copy of the most recently resolved frame, the root marker comes first
+		ML_NODISCARD auto get_results() const -> list<result>
+		{
+			std::unique_lock<std::mutex> lock{ m_mutex };
+			return m_results;
+		}
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		// record resolved frames until frame_count have been collected
+		void start_capture(size_t frame_count = 300);
+
+		void stop_capture() noexcept { std::unique_lock<std::mutex> lock{ m_mutex }; m_capture_frames = 0; }
+
+		ML_NODISCARD bool is_capturing() const noexcept { std::unique_lock<std::mutex> lock{ m_mutex }; return 0 < m_capture_frames; }
+
+		// captured frames in the chrome trace event format, or the last frame if nothing was captured
+		ML_NODISCARD json get_trace() const;
+
+		bool save_trace(fs::path const & path) const;
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	private:
+		ML_NODISCARD gfx::query_id acquire();
+
+		void collect(size_t slot);
+
+		pmr::synchronized_pool_resource	m_storage	; // recording storage, never the caller's resource
+
+		gfx::render_context *	m_context					; // context owning the queries
+		list<marker>			m_frames[frame_latency]		; // markers by frame slot
+		uint64					m_indices[frame_latency]	; // frame index by slot
+		size_t					m_slot						; // current slot
+		list<size_t>			m_stack						; // open markers
+		list<gfx::query_id>		m_pool						; // free queries
+		list<result>			m_results					; // last resolved frame
+		list<result>			m_capture					; // captured frames
+		size_t					m_capture_frames			; // frames left to capture
+		std::atomic<bool>		m_enabled					; // enabled
+		mutable std::mutex		m_mutex						; // guards results
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+	};
+}
+
+// scoped gpu marker
+#define ML_gpu_scope(profiler, ctx, name) \
+	_ML gpu_profiler::scope ML_anon{ profiler, ctx, name }
+
+#endif // !_ML_GPU_PROFILER_HPP_
\ No newline at end of file
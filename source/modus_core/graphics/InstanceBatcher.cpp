@@ -0,0 +1,69 @@
+#include <modus_core/graphics/InstanceBatcher.hpp>
+
+namespace ml
+{
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	static ref<gfx::streambuffer> _make_stream(size_t capacity) noexcept
+	{
+		return gfx::streambuffer::create(gfx::spec<gfx::streambuffer>{ capacity * sizeof(mat4) });
+	}
+
+	instance_batcher::instance_batcher(size_t capacity, allocator_type alloc) noexcept
+		: m_instances	{ alloc }
+		, m_transforms	{ alloc }
+		, m_batches		{ alloc }
+		, m_stream		{ _make_stream((std::max)(capacity, (size_t)1)) }
+		, m_capacity	{ (std::max)(capacity, (size_t)1) }
+		, m_prepared	{}
+	{
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	void instance_batcher::prepare()
+	{
+		m_prepared = true;
+		m_batches.clear();
+
+		size_t const count{ m_instances.size() };
+		if (!count) { return; }
+
+		// grow geometrically, vertexarrays pick up the new stream on their next draw
+		gfx::stream_range range{ m_stream->allocate(count * sizeof(mat4), sizeof(mat4)) };
+		if (!range.data)
+		{
+			while (m_capacity < count) { m_capacity *= 2; }
+
+			m_stream = _make_stream(m_capacity);
+
+			range = m_stream->allocate(count * sizeof(mat4), sizeof(mat4));
+
+			ML_assert(range.data);
+		}
+
+		// material first so each material is bound once, then mesh
+		std::sort(m_instances.begin(), m_instances.end(), [](instance const & a, instance const & b) noexcept
+		{
+			return (a.mtl != b.mtl) ? (a.mtl < b.mtl) : (a.msh < b.msh);
+		});
+
+		// transforms go straight into mapped memory in batch order
+		mat4 * const dst{ static_cast<mat4 *>(range.data) };
+		uint32 const base{ (uint32)(range.offset / sizeof(mat4)) };
+		for (size_t i = 0; i < count; ++i)
+		{
+			instance const & e{ m_instances[i] };
+
+			if (m_batches.empty() || m_batches.back().msh != e.msh || m_batches.back().mtl != e.mtl)
+			{
+				m_batches.push_back({ e.msh, e.mtl, base + (uint32)i, 0 });
+			}
+			++m_batches.back().count;
+
+			dst[i] = m_transforms[e.index];
+		}
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+#ifndef _ML_INSTANCE_BATCHER_HPP_
+#define _ML_INSTANCE_BATCHER_HPP_
+
+#include <modus_core/graphics/Material.hpp>
+#include <modus_core/graphics/Mesh.hpp>
+
+// INSTANCE BATCHER
+namespace ml
+{
+	// groups draws of the same mesh and material into instanced draws,
+	// transforms for every batch are written straight into a mapped streambuffer
+	struct ML_CORE_API instance_batcher final : non_copyable
+	{
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		using allocator_type = typename pmr::polymorphic_allocator<byte>;
+
+		// per instance attributes, after the mesh's own locations
+		static gfx::buffer_layout const & get_instance_layout() noexcept
+		{
+			static gfx::buffer_layout const layout{ {
+				{ mat4{}, "a_model", false, 1 },
+			} };
+			return layout;
+		}
+
+		struct ML_NODISCARD instance final
+		{
+			mesh const *		msh		; // mesh
+			material *			mtl		; // material
+			uint32				index	; // transform index
+		};
+
+		struct ML_NODISCARD batch final
+		{
+			mesh const *		msh		; // mesh
+			material *			mtl		; // material
+			uint32				first	; // base instance in stream
+			uint32				count	; // instance count
+		};
+
+		explicit instance_batcher(size_t capacity = 1024, allocator_type alloc = {}) noexcept;
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		// start a new frame, the stream moves on to its next region
+		void clear()
+		{
+			m_stream->next_frame();
+			m_instances.clear();
+			m_transforms.clear();
+			m_batches.clear();
+			m_prepared = false;
+		}
+
+		ML_NODISCARD bool empty() const noexcept { return m_instances.empty(); }
+
+		ML_NODISCARD auto size() const noexcept -> size_t { return m_instances.size(); }
+
+		ML_NODISCARD auto get_batches() const noexcept -> list<batch> const & { return m_batches; }
+
+		ML_NODISCARD auto get_capacity() const noexcept -> size_t { return m_capacity; }
+
+		ML_NODISCARD auto get_stream() const noexcept -> ref<gfx::streambuffer> const & { return m_stream; }
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		void push(mesh const * msh, material * mtl, mat4 const & transform)
+		{
+			ML_assert(msh && mtl);
+
+			m_instances.push_back({ msh, mtl, (uint32)m_transforms.size() });
+
+			m_transforms.push_back(transform);
+
+			m_prepared = false;
+		}
+
+		// group instances, stream their transforms, and build batches
+		void prepare();
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		// one instanced draw per batch, materials are uploaded and bound once each
+		template <class Context = gfx::render_context
+		> void execute(Context * ctx, uniform_ring & ring)
+		{
+			ML_assert(ctx);
+
+			if (!m_prepared) { prepare(); }
+
+			material * bound_material{};
+
+			for (batch const & b : m_batches)
+			{
+				if (b.mtl != bound_material)
+				{
+					b.mtl->upload(ring);
+					b.mtl->bind(ctx, ring);
+					bound_material = b.mtl;
+				}
+
+				auto const & vao{ b.msh->get_vertexarray() };
+
+				if (vao->get_stream() != m_stream)
+				{
+					vao->set_stream(m_stream, get_instance_layout(), vao->get_layout().location_count());
+				}
+
+				ctx->draw_instanced(vao.get(), b.count, b.first);
+			}
+		}
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	private:
+		list<instance>			m_instances	; // instances in push order
+		list<mat4>				m_transforms; // transforms in push order
+		list<batch>				m_batches	; // batches
+		ref<gfx::streambuffer>	m_stream	; // instance stream
+		size_t					m_capacity	; // instances per frame
+		bool					m_prepared	; // batches match instances
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+	};
+}
+
+#endif // !_ML_INSTANCE_BATCHER_HPP_
\ No newline at end of file
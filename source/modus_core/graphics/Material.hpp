@@ -1,34 +1,368 @@
 #ifndef _ML_MATERIAL_HPP_
 #define _ML_MATERIAL_HPP_
 
-// WIP
-
 #include <modus_core/graphics/Shader.hpp>
+#include <modus_core/graphics/TextureTable.hpp>
+
+#include <mutex>
 
+// UNIFORM BUFFER
 namespace ml
 {
-	struct uniform_buffer
+	// cpu side image of a std140 uniform block, laid out from the linked program
+	struct ML_NODISCARD uniform_buffer final
 	{
-		using storage_type = list<byte>;
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		using allocator_type	= typename pmr::polymorphic_allocator<byte>;
+		using storage_type		= typename list<byte>;
+		using layout_type		= typename gfx::uniform_block;
+
+		uniform_buffer(allocator_type alloc = {}) noexcept
+			: m_layout	{}
+			, m_data	{ alloc }
+			, m_dirty	{}
+		{
+		}
+
+		uniform_buffer(layout_type const & layout, allocator_type alloc = {}) noexcept
+			: uniform_buffer{ alloc }
+		{
+			reset(layout);
+		}
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		void reset(layout_type const & layout)
+		{
+			m_layout = layout;
+			m_data.assign((size_t)layout.size, byte{});
+			m_dirty = true;
+		}
+
+		ML_NODISCARD auto data() const noexcept -> byte const * { return m_data.data(); }
+
+		ML_NODISCARD auto size() const noexcept -> size_t { return m_data.size(); }
+
+		ML_NODISCARD auto get_layout() const noexcept -> layout_type const & { return m_layout; }
+
+		ML_NODISCARD bool is_dirty() const noexcept { return m_dirty; }
+
+		void set_dirty(bool value) noexcept { m_dirty = value; }
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		// write an array, elements are placed at the member's array stride
+		template <class T
+		> bool write(cstring name, size_t count, T const * value)
+		{
+			if (!name || !value) { return false; }
+			auto const it{ m_layout.members.find(hashof(name, std::strlen(name))) };
+			if (!it) { return false; }
+
+			gfx::uniform_block_member const & m{ *it->second };
+			size_t const stride{ m.array_stride ? (size_t)m.array_stride : sizeof(T) };
+			count = (std::min)(count, (size_t)(std::max)(m.array_size, 1u));
+			if (!count) { return false; }
+
+			// the value may not be wider than the member, and the last element has to fit the block
+			if (m.size && m.size < sizeof(T)) { return false; }
+			if (m_data.size() < (size_t)m.offset + (count - 1) * stride + element_extent(m, value[0])) { return false; }
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				write_element((size_t)m.offset + i * stride, m, value[i]);
+			}
+			return m_dirty = true;
+		}
+
+		template <class T
+		> bool write(cstring name, T const & value)
+		{
+			return write(name, 1, &value);
+		}
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	private:
+		template <class T
+		> static size_t element_extent(gfx::uniform_block_member const &, T const &) noexcept
+		{
+			return sizeof(T);
+		}
+
+		template <class T, size_t W, size_t H
+		> static size_t element_extent(gfx::uniform_block_member const & m, matrix<T, W, H> const &) noexcept
+		{
+			size_t const column{ H * sizeof(T) };
+			return (W - 1) * (m.matrix_stride ? (size_t)m.matrix_stride : column) + column;
+		}
+
+		template <class T
+		> void write_element(size_t offset, gfx::uniform_block_member const & m, T const & value)
+		{
+			ML_assert(offset + sizeof(T) <= m_data.size());
+
+			std::memcpy(m_data.data() + offset, &value, sizeof(T));
+		}
+
+		// std140 pads matrix columns out to the matrix stride
+		template <class T, size_t W, size_t H
+		> void write_element(size_t offset, gfx::uniform_block_member const & m, matrix<T, W, H> const & value)
+		{
+			size_t const column{ H * sizeof(T) };
+			size_t const stride{ m.matrix_stride ? (size_t)m.matrix_stride : column };
+
+			ML_assert(offset + (W - 1) * stride + column <= m_data.size());
+
+			for (size_t i = 0; i < W; ++i)
+			{
+				std::memcpy(m_data.data() + offset + i * stride, value.data() + i * H, column);
+			}
+		}
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		layout_type		m_layout	; // block layout
+		storage_type	m_data		; // std140 image
+		bool			m_dirty		; // changed since last upload
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+	};
+}
+
+// UNIFORM RING
+namespace ml
+{
+	// per frame uniform data in a persistently mapped streambuffer,
+	// blocks are written in place and bound by range instead of by buffer
+	struct ML_NODISCARD uniform_ring final
+	{
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		uniform_ring(size_t region_size, size_t frame_count = 3) noexcept
+			: m_buffer		{ gfx::streambuffer::create(gfx::spec<gfx::streambuffer>{ region_size, (uint32)frame_count }) }
+			, m_alignment	{ (std::max)((size_t)ML_get_global(gfx::render_device)->get_info().uniform_buffer_offset_alignment, (size_t)1) }
+		{
+		}
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		ML_NODISCARD auto get_buffer() const noexcept -> ref<gfx::streambuffer> const & { return m_buffer; }
+
+		ML_NODISCARD auto get_alignment() const noexcept -> size_t { return m_alignment; }
+
+		ML_NODISCARD auto get_frame() const noexcept -> size_t { return m_buffer->get_frame(); }
+
+		ML_NODISCARD auto get_region_size() const noexcept -> size_t { return m_buffer->get_region_size(); }
+
+		ML_NODISCARD auto get_used() const noexcept -> size_t { return m_buffer->get_used(); }
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		// move to the next frame's region, waits if the gpu is still reading it
+		void next_frame()
+		{
+			m_buffer->next_frame();
+		}
+
+		// returned by push when the region is full
+		static constexpr size_t npos{ static_cast<size_t>(-1) };
+
+		// reserve space in this frame's region to write a block in place, data is null if it is full
+		ML_NODISCARD gfx::stream_range allocate(size_t size)
+		{
+			gfx::stream_range const r{ m_buffer->allocate(size, m_alignment) };
+			if (!r.data) { debug::fail("uniform ring region overflow"); }
+			return r;
+		}
 
-		storage_type m_data;
+		// copy data into this frame's region, returns its offset in the buffer or npos
+		ML_NODISCARD size_t push(size_t size, addr_t data)
+		{
+			gfx::stream_range const r{ allocate(size) };
+			if (!r.data) { return npos; }
 
-		ML_NODISCARD auto operator->() const noexcept { return const_cast<storage_type *>(&m_data); }
+			std::memcpy(r.data, data, size);
 
-		ML_NODISCARD auto & operator*() const noexcept { return const_cast<storage_type &>(m_data); }
+			return r.offset;
+		}
 
-		template <class T> void write(cstring name, size_t count, T const * value)
+		ML_NODISCARD size_t push(uniform_buffer const & value)
 		{
-			size_t const size{ count * sizeof(T) };
+			return push(value.size(), (addr_t)value.data());
+		}
 
-			m_data.reserve(m_data.size() + size);
+		void bind(uint32 binding, size_t offset, size_t size) const noexcept
+		{
+			if (offset == npos) { return; }
 
-			std::memcpy(m_data.data(), value, size);
+			m_buffer->bind(binding, offset, size);
 		}
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	private:
+		ref<gfx::streambuffer>	m_buffer	; // buffer
+		size_t					m_alignment	; // offset alignment
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 	};
+}
 
-	struct material
+// MATERIAL
+namespace ml
+{
+	// program, textures, and the program's material block,
+	// written on the main thread and uploaded on the render thread
+	struct ML_NODISCARD material final
 	{
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		using allocator_type = typename pmr::polymorphic_allocator<byte>;
+
+		static constexpr cstring block_name{ "material_block" };
+
+		material(ref<gfx::program> const & pgm = {}, allocator_type alloc = {}) noexcept
+			: m_mutex		{}
+			, m_program		{}
+			, m_textures	{ alloc }
+			, m_block		{ alloc }
+			, m_offset		{}
+			, m_pending		{ alloc }
+			, m_reflected	{}
+		{
+			set_program(pgm);
+		}
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		// the old block and queued writes belong to the old program, reflection waits for upload
+		void set_program(ref<gfx::program> const & value)
+		{
+			std::unique_lock<std::mutex> lock{ m_mutex };
+			m_program = value;
+			m_block.reset({});
+			m_pending.clear();
+			m_reflected = false;
+		}
+
+		bool reflect()
+		{
+			std::unique_lock<std::mutex> lock{ m_mutex };
+			return do_reflect();
+		}
+
+		void set_texture(uint32 slot, ref<gfx::texture> const & value)
+		{
+			std::unique_lock<std::mutex> lock{ m_mutex };
+
+			if (m_textures.size() <= slot) { m_textures.resize((size_t)slot + 1); }
+
+			m_textures[slot] = value;
+		}
+
+		// write the texture's table index into the block instead of binding it
+		bool set_texture(cstring name, texture_table & table, ref<gfx::texture> const & value)
+		{
+			uint32 const index{ table.add(value) };
+
+			return (index != texture_table::invalid_index) && set(name, index);
+		}
+
+		template <class T
+		> bool set(cstring name, T const & value)
+		{
+			std::unique_lock<std::mutex> lock{ m_mutex };
+
+			if (m_reflected) { return m_block.write(name, value); }
+
+			if (!name) { return false; }
+
+			m_pending.push_back([key = string{ name }, value](uniform_buffer & b)
+			{
+				b.write(key.c_str(), value);
+			});
+			return true;
+		}
+
+		ML_NODISCARD auto get_program() const noexcept -> ref<gfx::program> const & { return m_program; }
+
+		ML_NODISCARD auto get_textures() const noexcept -> list<ref<gfx::texture>> const & { return m_textures; }
+
+		ML_NODISCARD auto get_block() const noexcept -> uniform_buffer const & { return m_block; }
+
+		ML_NODISCARD auto get_offset() const noexcept -> size_t { return m_offset; }
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		// copy the block into this frame's region of the ring
+		void upload(uniform_ring & ring)
+		{
+			std::unique_lock<std::mutex> lock{ m_mutex };
+
+			do_reflect();
+
+			if (!m_block.size()) { return; }
+
+			m_offset = ring.push(m_block);
+
+			m_block.set_dirty(false);
+		}
+
+		// bind program, textures, and the block range
+		void bind(gfx::render_context * ctx, uniform_ring const & ring) const
+		{
+			std::unique_lock<std::mutex> lock{ m_mutex };
+
+			ctx->bind_program(m_program.get());
+
+			for (size_t i = 0; i < m_textures.size(); ++i)
+			{
+				if (m_textures[i]) { ctx->bind_texture(m_textures[i].get(), (uint32)i); }
+			}
+
+			if (m_block.size() && m_offset != uniform_ring::npos)
+			{
+				ctx->bind_streambuffer(ring.get_buffer().get(), gfx::uniform_binding_material, m_offset, m_block.size());
+			}
+		}
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	private:
+		// the block layout is known once the program is ready, writes made before then are replayed
+		bool do_reflect()
+		{
+			if (m_reflected || !m_program || !m_program->ready()) { return m_reflected; }
+
+			m_reflected = true;
+
+			if (auto const block{ m_program->get_uniform_block(block_name) })
+			{
+				m_program->bind_uniform_block(block_name, gfx::uniform_binding_material);
+
+				m_block.reset(*block);
+			}
+
+			for (auto const & fn : m_pending) { fn(m_block); }
+
+			m_pending.clear();
+
+			return true;
+		}
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		mutable std::mutex						m_mutex		; // guards the program, block, and pending writes
+		ref<gfx::program>						m_program	; // program
+		list<ref<gfx::texture>>					m_textures	; // textures by slot
+		uniform_buffer							m_block		; // material block image
+		size_t									m_offset	; // offset in ring for this frame
+		list<method<void(uniform_buffer &)>>	m_pending	; // writes waiting for the program
+		bool									m_reflected	; // block matches the program
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 	};
 }
 
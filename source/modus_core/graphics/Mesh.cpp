@@ -14,15 +14,19 @@ namespace ml
 {
 	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
+	static constexpr int32 _default_flags
+	{
+		aiProcess_CalcTangentSpace |
+		aiProcess_Triangulate |
+		aiProcess_JoinIdenticalVertices |
+		aiProcess_SortByPType |
+		aiProcess_GenNormals |
+		aiProcess_GenUVCoords
+	};
+
 	list<vertex> mesh::load_from_file(fs::path const & path)
 	{
-		return load_from_file(path,
-			aiProcess_CalcTangentSpace |
-			aiProcess_Triangulate |
-			aiProcess_JoinIdenticalVertices |
-			aiProcess_SortByPType |
-			aiProcess_GenNormals |
-			aiProcess_GenUVCoords);
+		return load_from_file(path, _default_flags);
 	}
 
 	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
@@ -76,4 +80,71 @@ namespace ml
 	}
 
 	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	mesh::import_data mesh::import_from_file(fs::path const & path, bool compact)
+	{
+		import_data data{};
+		data.layout = compact ? get_compact_layout() : gfx::buffer_layout{};
+
+		// open scene
+		Assimp::Importer _ai;
+		aiScene const * s{ _ai.ReadFile(path.string().c_str(), _default_flags) };
+		ML_defer(&){ _ai.FreeScene(); };
+		if (!s) { return data; }
+
+		size_t const stride{ data.layout.stride() };
+
+		// for each mesh
+		std::for_each(&s->mMeshes[0], &s->mMeshes[s->mNumMeshes], [&](aiMesh * const m)
+		{
+			uint32 const base{ (uint32)(data.vertices.size() / stride) };
+
+			data.vertices.resize(data.vertices.size() + m->mNumVertices * stride);
+
+			byte * dst{ data.vertices.data() + (size_t)base * stride };
+
+			auto const write = [&dst](auto const & value) noexcept
+			{
+				std::memcpy(dst, &value, sizeof(value));
+				dst += sizeof(value);
+			};
+
+			// for each vertex
+			for (uint32 i = 0; i < m->mNumVertices; ++i)
+			{
+				auto const vp{ m->mVertices ? &m->mVertices[i] : nullptr };
+				auto const vn{ m->mNormals ? &m->mNormals[i] : nullptr };
+				auto const uv{ m->HasTextureCoords(0) ? &m->mTextureCoords[0][i] : nullptr };
+
+				vec3 const p{ vp ? vec3{ vp->x, vp->y, vp->z } : vec3::zero() };
+				vec3 const n{ vn ? vec3{ vn->x, vn->y, vn->z } : vec3::one() };
+				vec2 const t{ uv ? vec2{ uv->x, uv->y } : vec2::one() };
+
+				write(p);
+				if (compact)
+				{
+					write(gfx::pack_snorm_2_10_10_10(n));
+					write(gfx::pack_half(t));
+				}
+				else
+				{
+					write(n);
+					write(t);
+				}
+			}
+
+			// for each face
+			std::for_each(&m->mFaces[0], &m->mFaces[m->mNumFaces], [&](aiFace const & f)
+			{
+				std::for_each(&f.mIndices[0], &f.mIndices[f.mNumIndices], [&](uint32 i)
+				{
+					data.indices.push_back(base + i);
+				});
+			});
+		});
+
+		return data;
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 }
\ No newline at end of file
@@ -12,6 +12,27 @@ namespace ml
 	{
 		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
+		// indexed vertex data read from a file, packed in the given layout
+		struct ML_NODISCARD import_data final
+		{
+			list<byte>			vertices	; // packed vertices
+			list<uint32>		indices		; // indices
+			gfx::buffer_layout	layout		; // vertex layout
+		};
+
+		// position, normal as 2_10_10_10, and half texcoord in 20 bytes instead of 32
+		static gfx::buffer_layout const & get_compact_layout() noexcept
+		{
+			static gfx::buffer_layout const layout{ {
+				{ vec3{}, "a_position" },
+				{ gfx::packed_2_10_10_10{}, "a_normal", true },
+				{ gfx::vec2h{}, "a_texcoord" },
+			} };
+			return layout;
+		}
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
 		mesh(uint32 mode = gfx::primitive_triangles) noexcept
 			: m_va{ gfx::vertexarray::create({ mode }) }
 		{
@@ -47,6 +68,14 @@ namespace ml
 		{
 		}
 
+		mesh(import_data const & value)
+			: mesh{}
+		{
+			set_layout(value.layout);
+			add_vertices(value.vertices);
+			set_indices(value.indices);
+		}
+
 		mesh(mesh && other) noexcept : m_va{}
 		{
 			swap(std::move(other));
@@ -93,6 +122,17 @@ namespace ml
 			}
 		}
 
+		// packed vertices, the layout's stride is a multiple of four bytes
+		void add_vertices(list<byte> const & value) noexcept
+		{
+			ML_assert(value.size() % sizeof(float32) == 0);
+
+			add_vertices(gfx::vertexbuffer::create({
+				gfx::usage_static,
+				value.size() / sizeof(float32),
+				value.data() }));
+		}
+
 		void set_layout(gfx::buffer_layout const & value) noexcept
 		{
 			m_va->set_layout(value);
@@ -103,9 +143,20 @@ namespace ml
 			m_va->set_indices(value);
 		}
 
+		// 16-bit indices whenever every vertex is reachable with them
 		void set_indices(list<uint32> const & value) noexcept
 		{
 			if (value.empty()) { set_indices(nullptr); }
+			else if (*std::max_element(value.begin(), value.end()) <= 0xffff)
+			{
+				list<uint16> const narrow{ value.begin(), value.end() };
+
+				set_indices(gfx::indexbuffer::create({
+					gfx::usage_static,
+					narrow.size(),
+					narrow.data(),
+					gfx::type_ushort }));
+			}
 			else
 			{
 				set_indices(gfx::indexbuffer::create({
@@ -121,6 +172,8 @@ namespace ml
 
 		static list<vertex> load_from_file(fs::path const & path, int32 flags);
 
+		static import_data import_from_file(fs::path const & path, bool compact = false);
+
 		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 		auto get_vertexarray() const & noexcept -> ref<gfx::vertexarray> const & { return m_va; }
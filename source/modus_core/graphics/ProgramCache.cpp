@@ -0,0 +1,214 @@
+#include <modus_core/graphics/ProgramCache.hpp>
+
+namespace ml
+{
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	// sources run to many kilobytes, so fold them in a loop rather than recursively
+	static hash_t _hash_string(string const & value, hash_t seed) noexcept
+	{
+		seed = gfx::hash_fields(seed, value.size());
+		for (char const c : value) { seed = (seed ^ static_cast<hash_t>(c)) * fnv1a_prime; }
+		return seed;
+	}
+
+	// defines go after #version, which must stay the first line
+	static string _apply_defines(string const & src, list<string> const & defines)
+	{
+		if (defines.empty()) { return src; }
+
+		string prefix{};
+		for (string const & e : defines) { prefix += "#define " + e + '\n'; }
+
+		string result{ src };
+		if (size_t const pos{ result.find("#version") }; pos == string::npos)
+		{
+			result.insert(0, prefix);
+		}
+		else if (size_t const end{ result.find('\n', pos) }; end == string::npos)
+		{
+			result += '\n' + prefix;
+		}
+		else
+		{
+			result.insert(end + 1, prefix);
+		}
+		return result;
+	}
+
+	program_cache::program_cache(fs::path const & directory)
+		: m_directory	{ directory }
+		, m_driver		{}
+		, m_hits		{}
+		, m_misses		{}
+		, m_mutex		{}
+		, m_pending		{}
+	{
+		ML_ctor_global(program_cache);
+
+		auto const & info{ ML_get_global(gfx::render_device)->get_info() };
+		m_driver = _hash_string(info.vendor, fnv1a_basis);
+		m_driver = _hash_string(info.renderer, m_driver);
+		m_driver = _hash_string(info.version, m_driver);
+
+		std::error_code ec{};
+		fs::create_directories(m_directory, ec);
+	}
+
+	program_cache::~program_cache() noexcept
+	{
+		ML_dtor_global(program_cache);
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	ref<gfx::program> program_cache::load(gfx::program_source const & src, list<string> const & defines)
+	{
+		hash_t const key{ make_key(src, defines) };
+
+		ref<gfx::program> value{ gfx::program::create({}) };
+
+		if (read(key, value.get())) { ++m_hits; return value; }
+
+		++m_misses;
+
+		for (size_t i = 0; i < src.size(); ++i)
+		{
+			if (src[i]) { value->attach((uint32)i, _apply_defines(*src[i], defines)); }
+		}
+
+		if (!value->link()) { debug::warn(value->get_info_log()); return nullptr; }
+
+		write(key, value.get());
+
+		return value;
+	}
+
+	ref<gfx::program> program_cache::load_async(gfx::program_source const & src, list<string> const & defines)
+	{
+		hash_t const key{ make_key(src, defines) };
+
+		ref<gfx::program> value{ gfx::program::create({}) };
+
+		if (read(key, value.get())) { ++m_hits; return value; }
+
+		++m_misses;
+
+		for (size_t i = 0; i < src.size(); ++i)
+		{
+			if (src[i]) { value->attach_async((uint32)i, _apply_defines(*src[i], defines)); }
+		}
+
+		value->link_async();
+
+		std::unique_lock<std::mutex> lock{ m_mutex };
+		m_pending.push_back({ key, value });
+		return value;
+	}
+
+	size_t program_cache::flush()
+	{
+		std::unique_lock<std::mutex> lock{ m_mutex };
+
+		size_t written{};
+		for (auto it{ m_pending.begin() }; it != m_pending.end();)
+		{
+			ref<gfx::program> const value{ it->second.lock() };
+
+			uint32 const status{ value ? value->get_status() : (uint32)gfx::program_status_failed };
+
+			if (status == gfx::program_status_compiling) { ++it; continue; }
+
+			if (status == gfx::program_status_ready && write(it->first, value.get())) { ++written; }
+
+			it = m_pending.erase(it);
+		}
+		return written;
+	}
+
+	hash_t program_cache::make_key(gfx::program_source const & src, list<string> const & defines) const noexcept
+	{
+		hash_t seed{ m_driver };
+		for (size_t i = 0; i < src.size(); ++i)
+		{
+			if (!src[i]) { continue; }
+
+			seed = gfx::hash_fields(seed, (uint32)i);
+
+			seed = _hash_string(*src[i], seed);
+		}
+		for (string const & e : defines)
+		{
+			seed = _hash_string(e, seed);
+		}
+		return seed;
+	}
+
+	fs::path program_cache::get_path(hash_t key) const
+	{
+		char name[32]{};
+		std::snprintf(name, sizeof(name), "%016llx.bin", (unsigned long long)key);
+		return m_directory / name;
+	}
+
+	void program_cache::clear()
+	{
+		std::error_code ec{};
+		for (auto const & e : fs::directory_iterator{ m_directory, ec })
+		{
+			if (e.path().extension() == ".bin") { fs::remove(e.path(), ec); }
+		}
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	bool program_cache::read(hash_t key, gfx::program * value) const
+	{
+		fs::path const path{ get_path(key) };
+
+		std::error_code ec{};
+		uintmax_t const file_size{ fs::file_size(path, ec) };
+		if (ec || file_size < sizeof(header)) { return false; }
+
+		std::ifstream f{ path, std::ios::binary };
+		if (!f) { return false; }
+
+		// the size comes from disk, so check it against the file before allocating
+		header h{};
+		if (!f.read((char *)&h, sizeof(header)) || h.magic != magic || h.key != key || !h.size) { return false; }
+		if (h.size != file_size - sizeof(header)) { return false; }
+
+		list<byte> data((size_t)h.size);
+		if (!f.read((char *)data.data(), (std::streamsize)data.size())) { return false; }
+
+		return value->load_binary(h.format, data.data(), data.size());
+	}
+
+	bool program_cache::write(hash_t key, gfx::program const * value) const
+	{
+		header h{ magic, 0, key, 0 };
+
+		list<byte> data{};
+		if (!value->get_binary(h.format, data)) { return false; }
+		h.size = data.size();
+
+		std::ofstream f{ get_path(key), std::ios::binary | std::ios::trunc };
+		if (!f) { return false; }
+
+		f.write((char const *)&h, sizeof(header));
+		f.write((char const *)data.data(), (std::streamsize)data.size());
+		return (bool)f;
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+}
+
+// global program_cache
+namespace ml::globals
+{
+	static program_cache * g_program_cache{};
+
+	ML_impl_global(program_cache) get_global() { return g_program_cache; }
+
+	ML_impl_global(program_cache) set_global(program_cache * value) { return g_program_cache = value; }
+}
\ No newline at end of file
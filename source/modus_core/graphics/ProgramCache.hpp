@@ -0,0 +1,95 @@
+#ifndef _ML_PROGRAM_CACHE_HPP_
+#define _ML_PROGRAM_CACHE_HPP_
+
+#include <modus_core/graphics/Shader.hpp>
+
+#include <mutex>
+
+// PROGRAM CACHE
+namespace ml
+{
+	// linked program binaries on disk, keyed by source, defines, and driver,
+	// anything that is missing or rejected is compiled from source and stored
+	struct ML_CORE_API program_cache final : non_copyable
+	{
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		// file header, followed by the binary
+		struct ML_NODISCARD header final
+		{
+			uint32	magic	; // file magic
+			uint32	format	; // driver binary format
+			hash_t	key		; // full cache key
+			uint64	size	; // binary size in bytes
+		};
+
+		static constexpr uint32 magic{ 0x4d4c5042 }; // MLPB
+
+		explicit program_cache(fs::path const & directory);
+
+		~program_cache() noexcept;
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		// defines are inserted after each stage's #version line, returns nullptr if linking fails
+		ML_NODISCARD ref<gfx::program> load(gfx::program_source const & src, list<string> const & defines = {});
+
+		// a hit is ready at once, a miss links in the background and is stored by flush
+		ML_NODISCARD ref<gfx::program> load_async(gfx::program_source const & src, list<string> const & defines = {});
+
+		template <class In
+		> ML_NODISCARD ref<gfx::program> load_source(In && in, list<string> const & defines = {})
+		{
+			gfx::program_source src{};
+
+			return gfx::parse_source(ML_forward(in), src) ? load(src, defines) : nullptr;
+		}
+
+		ML_NODISCARD hash_t make_key(gfx::program_source const & src, list<string> const & defines = {}) const noexcept;
+
+		ML_NODISCARD fs::path get_path(hash_t key) const;
+
+		// store binaries of background links that have finished, call where programs are polled
+		size_t flush();
+
+		// delete every cached binary
+		void clear();
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		ML_NODISCARD auto get_directory() const noexcept -> fs::path const & { return m_directory; }
+
+		ML_NODISCARD auto get_hits() const noexcept -> size_t { return m_hits; }
+
+		ML_NODISCARD auto get_misses() const noexcept -> size_t { return m_misses; }
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	private:
+		bool read(hash_t key, gfx::program * value) const;
+
+		bool write(hash_t key, gfx::program const * value) const;
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		fs::path	m_directory	; // cache directory
+		hash_t		m_driver	; // vendor, renderer, and version
+		size_t		m_hits		; // programs loaded from binaries
+		size_t		m_misses	; // programs compiled from source
+
+		std::mutex								m_mutex		; // guards pending links
+		list<std::pair<hash_t, weak<gfx::program>>>	m_pending	; // background links to store
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+	};
+}
+
+// global program_cache
+namespace ml::globals
+{
+	ML_decl_global(program_cache) get_global();
+
+	ML_decl_global(program_cache) set_global(program_cache *);
+}
+
+#endif // !_ML_PROGRAM_CACHE_HPP_
\ No newline at end of file
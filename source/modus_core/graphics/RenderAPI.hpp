@@ -4,6 +4,8 @@
 #include <modus_core/window/ContextSettings.hpp>
 #include <modus_core/graphics/RenderUtility.hpp>
 
+#include <atomic>
+
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 // types
@@ -14,13 +16,20 @@ namespace ml::gfx
 	struct	vertexarray		; // 
 	struct	vertexbuffer	; // 
 	struct	indexbuffer		; // 
+	struct	uniformbuffer	; // 
+	struct	streambuffer	; // 
+	struct	storagebuffer	; // 
 	struct	texture			; // 
 	struct	texture2d		; // 
+	struct	texture2d_array	; // 
 	struct	texture3d		; // WIP
 	struct	texturecube		; // WIP
 	struct	framebuffer		; // 
 	struct	program			; // 
 	struct	shader			; // WIP
+	struct	pipeline_state	; // 
+
+	struct	command_buffer	; // 
 }
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
@@ -38,16 +47,93 @@ namespace ml::gfx
 
 		// textures
 		bool texture_edge_clamp_available;
+		bool bindless_textures_available;
 		uint32 max_texture_slots;
+		uint32 max_array_texture_layers;
 
 		// framebuffers
 		uint32 max_color_attachments;
 		uint32 max_samples;
 
+		// uniform buffers
+		uint32 max_uniform_buffer_bindings;
+		uint32 max_uniform_block_size;
+		uint32 uniform_buffer_offset_alignment;
+
 		// shaders
 		bool shaders_available;
 		bool geometry_shaders_available;
+		bool program_binaries_available;
+		bool parallel_shader_compile_available;
 		string shading_language_version;
+
+		// compute
+		bool compute_shaders_available;
+		vec3u max_compute_work_group_count;
+		vec3u max_compute_work_group_size;
+		uint32 max_compute_work_group_invocations;
+		uint32 max_storage_buffer_bindings;
+		uint32 storage_buffer_offset_alignment;
+		uint32 max_image_units;
+	};
+
+	// render stats, counted per frame
+	struct ML_NODISCARD render_stats final
+	{
+		// draws
+		uint64 draw_calls, primitives, dispatches;
+
+		// binds
+		uint64 program_binds, texture_binds, vertexarray_binds, framebuffer_binds;
+
+		// uploads
+		uint64 uniform_uploads, bytes_uploaded;
+
+		// resources
+		uint64 objects_created, objects_destroyed;
+	};
+
+	inline void to_json(json & j, render_stats const & v)
+	{
+		j["draw_calls"			] = v.draw_calls;
+		j["primitives"			] = v.primitives;
+		j["dispatches"			] = v.dispatches;
+		j["program_binds"		] = v.program_binds;
+		j["texture_binds"		] = v.texture_binds;
+		j["vertexarray_binds"	] = v.vertexarray_binds;
+		j["framebuffer_binds"	] = v.framebuffer_binds;
+		j["uniform_uploads"		] = v.uniform_uploads;
+		j["bytes_uploaded"		] = v.bytes_uploaded;
+		j["objects_created"		] = v.objects_created;
+		j["objects_destroyed"	] = v.objects_destroyed;
+	}
+
+	// counters of the frame in progress, bumped from both the render and main threads
+	struct ML_NODISCARD render_counters final
+	{
+		std::atomic<uint64>
+			draw_calls{}, primitives{}, dispatches{},
+			program_binds{}, texture_binds{}, vertexarray_binds{}, framebuffer_binds{},
+			uniform_uploads{}, bytes_uploaded{},
+			objects_created{}, objects_destroyed{};
+
+		// counters are only read once a frame is flushed, so no ordering is needed
+		static void add(std::atomic<uint64> & value, uint64 count = 1) noexcept
+		{
+			value.fetch_add(count, std::memory_order_relaxed);
+		}
+
+		// read and reset every counter
+		ML_NODISCARD render_stats exchange() noexcept
+		{
+			auto take = [](std::atomic<uint64> & value) noexcept { return value.exchange(0, std::memory_order_relaxed); };
+			return {
+				take(draw_calls), take(primitives), take(dispatches),
+				take(program_binds), take(texture_binds), take(vertexarray_binds), take(framebuffer_binds),
+				take(uniform_uploads), take(bytes_uploaded),
+				take(objects_created), take(objects_destroyed)
+			};
+		}
 	};
 
 	// render device specification
@@ -86,6 +172,20 @@ namespace ml::gfx
 
 		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
+		// counters of the last completed frame
+		ML_NODISCARD virtual render_stats get_stats() const = 0;
+
+		// counters of the frame in progress
+		ML_NODISCARD virtual render_counters & get_frame_stats() noexcept = 0;
+
+		// publish the frame in progress and start counting the next
+		virtual void flush_stats() = 0;
+
+		// advance programs that are still compiling, returns how many are left
+		virtual size_t poll_programs() = 0;
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
 		ML_NODISCARD virtual ref<render_context> const & get_context() const noexcept = 0;
 
 		virtual void set_context(ref<render_context> const & value) noexcept = 0;
@@ -100,7 +200,15 @@ namespace ml::gfx
 
 		ML_NODISCARD virtual ref<indexbuffer> new_indexbuffer(spec<indexbuffer> const & desc, allocator_type alloc = {}) noexcept = 0;
 
+		ML_NODISCARD virtual ref<uniformbuffer> new_uniformbuffer(spec<uniformbuffer> const & desc, allocator_type alloc = {}) noexcept = 0;
+
+		ML_NODISCARD virtual ref<streambuffer> new_streambuffer(spec<streambuffer> const & desc, allocator_type alloc = {}) noexcept = 0;
+
+		ML_NODISCARD virtual ref<storagebuffer> new_storagebuffer(spec<storagebuffer> const & desc, allocator_type alloc = {}) noexcept = 0;
+
 		ML_NODISCARD virtual ref<texture2d> new_texture2d(spec<texture2d> const & desc, allocator_type alloc = {}) noexcept = 0;
+
+		ML_NODISCARD virtual ref<texture2d_array> new_texture2d_array(spec<texture2d_array> const & desc, allocator_type alloc = {}) noexcept = 0;
 		
 		ML_NODISCARD virtual ref<texture3d> new_texture3d(spec<texture3d> const & desc, allocator_type alloc = {}) noexcept = 0;
 
@@ -112,6 +220,8 @@ namespace ml::gfx
 
 		ML_NODISCARD virtual ref<shader> new_shader(spec<shader> const & desc, allocator_type alloc = {}) noexcept = 0;
 
+		ML_NODISCARD virtual ref<pipeline_state> new_pipeline_state(spec<pipeline_state> const & desc, allocator_type alloc = {}) noexcept = 0;
+
 		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 		ML_NODISCARD virtual list<weak<render_context>> const & all_contexts() const noexcept = 0;
@@ -122,8 +232,16 @@ namespace ml::gfx
 
 		ML_NODISCARD virtual list<weak<indexbuffer>> const & all_indexbuffers() const noexcept = 0;
 
+		ML_NODISCARD virtual list<weak<uniformbuffer>> const & all_uniformbuffers() const noexcept = 0;
+
+		ML_NODISCARD virtual list<weak<streambuffer>> const & all_streambuffers() const noexcept = 0;
+
+		ML_NODISCARD virtual list<weak<storagebuffer>> const & all_storagebuffers() const noexcept = 0;
+
 		ML_NODISCARD virtual list<weak<texture2d>> const & all_texture2ds() const noexcept = 0;
 
+		ML_NODISCARD virtual list<weak<texture2d_array>> const & all_texture2d_arrays() const noexcept = 0;
+
 		ML_NODISCARD virtual list<weak<texture3d>> const & all_texture3ds() const noexcept = 0;
 
 		ML_NODISCARD virtual list<weak<texturecube>> const & all_texturecubes() const noexcept = 0;
@@ -134,6 +252,8 @@ namespace ml::gfx
 
 		ML_NODISCARD virtual list<weak<shader>> const & all_shaders() const noexcept = 0;
 
+		ML_NODISCARD virtual list<weak<pipeline_state>> const & all_pipeline_states() const noexcept = 0;
+
 		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 	};
 
@@ -189,9 +309,13 @@ namespace ml::gfx
 
 		explicit render_object(render_device * parent) noexcept : m_parent{ ML_check(parent) }
 		{
+			render_counters::add(m_parent->get_frame_stats().objects_created);
 		}
 
-		virtual ~render_object() override = default;
+		virtual ~render_object() override
+		{
+			render_counters::add(m_parent->get_frame_stats().objects_destroyed);
+		}
 
 		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
@@ -302,6 +426,12 @@ namespace ml::gfx
 			, ML_forward(args)...);
 		}
 
+		// decode a packet buffer
+		virtual void submit(command_buffer const & value) = 0;
+
+		// forget shadowed state, required after gl is touched outside of the context
+		virtual void invalidate_cache() = 0;
+
 		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 		virtual alpha_state * get_alpha_state(alpha_state * value = {}) const = 0;
@@ -338,30 +468,98 @@ namespace ml::gfx
 
 		virtual void clear(uint32 mask) = 0;
 
-		virtual void draw(ref<vertexarray> const & value) = 0;
+		virtual void draw(vertexarray const * value) = 0;
+
+		void draw(ref<vertexarray> const & value) { draw(value.get()); }
 
 		virtual void draw_arrays(uint32 prim, size_t first, size_t count) = 0;
 
 		virtual void draw_indexed(uint32 prim, size_t count) = 0;
 
+		virtual void draw_instanced(vertexarray const * value, size_t instances, size_t first_instance = 0) = 0;
+
+		void draw_instanced(ref<vertexarray> const & value, size_t instances, size_t first_instance = 0) { draw_instanced(value.get(), instances, first_instance); }
+
+		virtual void draw_arrays_instanced(uint32 prim, size_t first, size_t count, size_t instances, size_t first_instance = 0) = 0;
+
+		virtual void draw_indexed_instanced(uint32 prim, size_t count, size_t instances, size_t first_instance = 0) = 0;
+
+		// draw_indirect_commands read from a streambuffer, indices are 32 bit
+		virtual void draw_indexed_indirect(uint32 prim, streambuffer const * buffer, size_t offset, size_t count) = 0;
+
+		// draw_indirect_commands written on the gpu, e.g. by a culling pass
+		virtual void draw_indexed_indirect(uint32 prim, storagebuffer const * buffer, size_t offset, size_t count) = 0;
+
 		virtual void flush() = 0;
 
 		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
+		// run the bound compute program over x * y * z work groups
+		virtual void dispatch(uint32 x, uint32 y = 1, uint32 z = 1) = 0;
+
+		// a dispatch_indirect_command read from a storagebuffer
+		virtual void dispatch_indirect(storagebuffer const * buffer, size_t offset = 0) = 0;
+
+		// make earlier shader writes visible to the reads named by the barrier flags
+		virtual void memory_barrier(uint32 mask = barrier_flags_all) = 0;
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		// signals once everything issued before it has completed
+		ML_NODISCARD virtual sync_id insert_fence() = 0;
+
+		// waits up to timeout nanoseconds, true once the fence has signaled
+		virtual bool wait_fence(sync_id value, uint64 timeout = 0) = 0;
+
+		virtual void delete_fence(sync_id value) = 0;
+
+		ML_NODISCARD virtual query_id new_query() = 0;
+
+		virtual void delete_query(query_id value) = 0;
+
+		// records the gpu clock once everything issued before it has completed
+		virtual void query_timestamp(query_id value) = 0;
+
+		// nanoseconds, false while the result is still pending
+		virtual bool get_query_result(query_id value, uint64 & result) = 0;
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
 		virtual void bind_vertexarray(vertexarray const * value) = 0;
 
 		virtual void bind_vertexbuffer(vertexbuffer const * value) = 0;
 
 		virtual void bind_indexbuffer(indexbuffer const * value) = 0;
 
+		// size of zero binds from offset to the end of the buffer
+		virtual void bind_uniformbuffer(uniformbuffer const * value, uint32 binding, size_t offset = 0, size_t size = 0) = 0;
+
+		// bind a range of a streambuffer as a uniform block
+		virtual void bind_streambuffer(streambuffer const * value, uint32 binding, size_t offset, size_t size) = 0;
+
+		// size of zero binds from offset to the end of the buffer
+		virtual void bind_storagebuffer(storagebuffer const * value, uint32 binding, size_t offset = 0, size_t size = 0) = 0;
+
 		virtual void bind_texture(texture const * value, uint32 slot = 0) = 0;
 
+		// bind one mip level of a texture for image load/store, arrays bind every layer,
+		// the texture needs a sized color format such as format_rgba8 or format_rgba32f
+		virtual void bind_image(texture const * value, uint32 unit, uint32 access = image_access_read_write, uint32 level = 0) = 0;
+
 		virtual void bind_framebuffer(framebuffer const * value) = 0;
 
+		// programs that are not ready are replaced by the fallback program
 		virtual void bind_program(program const * value) = 0;
 
+		ML_NODISCARD virtual ref<program> const & get_fallback_program() const noexcept = 0;
+
+		virtual void set_fallback_program(ref<program> const & value) = 0;
+
 		virtual void bind_shader(shader const * value) = 0; // WIP
 
+		// applies only the parts that differ from the last bound pipeline
+		virtual void bind_pipeline_state(pipeline_state const * value) = 0;
+
 		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 		virtual void upload(uniform_id loc, bool value) = 0;
@@ -436,10 +634,20 @@ namespace ml::gfx
 
 		virtual void set_indices(ref<indexbuffer> const & value) = 0;
 
+		// per instance attributes, placed after the vertex layout's locations
+		virtual void set_instances(ref<vertexbuffer> const & value, buffer_layout const & layout) = 0;
+
+		// attributes sourced from a streambuffer, draws pick the region by first vertex or instance
+		virtual void set_stream(ref<streambuffer> const & value, buffer_layout const & layout, uint32 first_location) = 0;
+
 		ML_NODISCARD virtual buffer_layout const & get_layout() const noexcept = 0;
 
 		ML_NODISCARD virtual ref<indexbuffer> const & get_indices() const noexcept = 0;
 
+		ML_NODISCARD virtual ref<vertexbuffer> const & get_instances() const noexcept = 0;
+
+		ML_NODISCARD virtual ref<streambuffer> const & get_stream() const noexcept = 0;
+
 		ML_NODISCARD virtual uint32 get_mode() const noexcept = 0;
 		
 		ML_NODISCARD virtual list<ref<vertexbuffer>> const & get_vertices() const noexcept = 0;
@@ -505,6 +713,7 @@ namespace ml::gfx
 		ML_NODISCARD virtual typeof_t<> const & get_self_type() const noexcept override = 0;
 
 	public:
+		// count is in floats, offset is in bytes, the write must fit the existing store
 		virtual void set_data(size_t count, addr_t data, size_t offset = 0) = 0;
 
 		ML_NODISCARD virtual buffer_t const & get_buffer() const noexcept = 0;
@@ -539,18 +748,21 @@ namespace ml::gfx
 		uint32	usage	{ usage_static };
 		size_t	count	{};
 		addr_t	data	{ nullptr };
+		uint32	type	{ type_uint }; // type_ushort or type_uint
 	};
 
 	static void from_json(json const & j, spec<indexbuffer> & v)
 	{
 		j["usage"].get_to(v.usage);
 		j["count"].get_to(v.count);
+		if (j.contains("type")) { j["type"].get_to(v.type); }
 	}
 
 	static void to_json(json & j, spec<indexbuffer> const & v)
 	{
 		j["usage"] = v.usage;
 		j["count"] = v.count;
+		j["type"] = v.type;
 	}
 
 
@@ -578,6 +790,7 @@ namespace ml::gfx
 		ML_NODISCARD virtual typeof_t<> const & get_self_type() const noexcept override = 0;
 
 	public:
+		// count is in indices of the buffer's type, offset is in bytes, the write must fit the existing store
 		virtual void set_data(size_t count, addr_t data, size_t offset = 0) = 0;
 
 		ML_NODISCARD virtual buffer_t const & get_buffer() const noexcept = 0;
@@ -588,6 +801,8 @@ namespace ml::gfx
 
 		ML_NODISCARD virtual uint32 get_usage() const noexcept = 0;
 
+		ML_NODISCARD virtual uint32 get_type() const noexcept = 0;
+
 	public:
 		inline void bind() const noexcept
 		{
@@ -603,6 +818,233 @@ namespace ml::gfx
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
+// uniformbuffer
+namespace ml::gfx
+{
+	// well known uniform block bindings
+	enum uniform_binding_ : uint32
+	{
+		uniform_binding_frame,
+		uniform_binding_material,
+		uniform_binding_object,
+		uniform_binding_textures,
+	};
+
+	// uniformbuffer specification
+	template <> struct ML_NODISCARD spec<uniformbuffer> final
+	{
+		uint32	usage	{ usage_dynamic };
+		size_t	size	{};
+		addr_t	data	{ nullptr };
+	};
+
+	static void from_json(json const & j, spec<uniformbuffer> & v)
+	{
+		j["usage"].get_to(v.usage);
+		j["size"].get_to(v.size);
+	}
+
+	static void to_json(json & j, spec<uniformbuffer> const & v)
+	{
+		j["usage"] = v.usage;
+		j["size"] = v.size;
+	}
+
+	// base uniformbuffer
+	struct ML_CORE_API uniformbuffer : public render_object<uniformbuffer>
+	{
+	public:
+		using spec_type = typename spec<uniformbuffer>;
+
+		template <class Desc = spec_type
+		> ML_NODISCARD static auto create(Desc && desc, allocator_type alloc = {}) noexcept
+		{
+			return ML_get_global(render_device)->new_uniformbuffer(ML_forward(desc), alloc);
+		}
+
+	public:
+		explicit uniformbuffer(render_device * parent) noexcept : render_object{ parent } {}
+
+		virtual ~uniformbuffer() override = default;
+
+		virtual bool revalue() = 0;
+
+		ML_NODISCARD virtual object_id get_handle() const noexcept override = 0;
+
+		ML_NODISCARD virtual typeof_t<> const & get_self_type() const noexcept override = 0;
+
+	public:
+		// no local copy is kept, uniform data changes every frame
+		virtual void set_data(size_t size, addr_t data, size_t offset = 0) = 0;
+
+		ML_NODISCARD virtual size_t get_size() const noexcept = 0;
+
+		ML_NODISCARD virtual uint32 get_usage() const noexcept = 0;
+
+	public:
+		inline void bind(uint32 binding, size_t offset = 0, size_t size = 0) const noexcept
+		{
+			get_context()->bind_uniformbuffer(this, binding, offset, size);
+		}
+
+		inline void unbind(uint32 binding) const noexcept
+		{
+			get_context()->bind_uniformbuffer(nullptr, binding);
+		}
+	};
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+// streambuffer
+namespace ml::gfx
+{
+	// streambuffer specification
+	template <> struct ML_NODISCARD spec<streambuffer> final
+	{
+		size_t	size	{}; // bytes per frame
+		uint32	frames	{ 3 }; // frames in flight
+	};
+
+	static void from_json(json const & j, spec<streambuffer> & v)
+	{
+		j["size"].get_to(v.size);
+		j["frames"].get_to(v.frames);
+	}
+
+	static void to_json(json & j, spec<streambuffer> const & v)
+	{
+		j["size"] = v.size;
+		j["frames"] = v.frames;
+	}
+
+	// sub allocation of a streambuffer, data is null if the region is full
+	struct ML_NODISCARD stream_range final
+	{
+		void *	data	; // write pointer
+		size_t	offset	; // offset from the start of the buffer
+		size_t	size	; // size in bytes
+	};
+
+	// base streambuffer
+	struct ML_CORE_API streambuffer : public render_object<streambuffer>
+	{
+	public:
+		using spec_type = typename spec<streambuffer>;
+
+		template <class Desc = spec_type
+		> ML_NODISCARD static auto create(Desc && desc, allocator_type alloc = {}) noexcept
+		{
+			return ML_get_global(render_device)->new_streambuffer(ML_forward(desc), alloc);
+		}
+
+	public:
+		explicit streambuffer(render_device * parent) noexcept : render_object{ parent } {}
+
+		virtual ~streambuffer() override = default;
+
+		virtual bool revalue() = 0;
+
+		ML_NODISCARD virtual object_id get_handle() const noexcept override = 0;
+
+		ML_NODISCARD virtual typeof_t<> const & get_self_type() const noexcept override = 0;
+
+	public:
+		// fence the current region, then wait until the next one is free
+		virtual void next_frame() = 0;
+
+		// reserve space in the current region, writes are visible to the gpu without a copy
+		ML_NODISCARD virtual stream_range allocate(size_t size, size_t alignment = 16) = 0;
+
+		ML_NODISCARD virtual size_t get_frame() const noexcept = 0;
+
+		ML_NODISCARD virtual size_t get_frame_count() const noexcept = 0;
+
+		ML_NODISCARD virtual size_t get_region_size() const noexcept = 0;
+
+		ML_NODISCARD virtual size_t get_used() const noexcept = 0;
+
+	public:
+		inline void bind(uint32 binding, size_t offset, size_t size) const noexcept
+		{
+			get_context()->bind_streambuffer(this, binding, offset, size);
+		}
+	};
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+// storagebuffer
+namespace ml::gfx
+{
+	// storagebuffer specification
+	template <> struct ML_NODISCARD spec<storagebuffer> final
+	{
+		uint32	usage	{ usage_dynamic };
+		size_t	size	{};
+		addr_t	data	{ nullptr };
+	};
+
+	static void from_json(json const & j, spec<storagebuffer> & v)
+	{
+		j["usage"].get_to(v.usage);
+		j["size"].get_to(v.size);
+	}
+
+	static void to_json(json & j, spec<storagebuffer> const & v)
+	{
+		j["usage"] = v.usage;
+		j["size"] = v.size;
+	}
+
+	// base storagebuffer, read and written by shaders
+	struct ML_CORE_API storagebuffer : public render_object<storagebuffer>
+	{
+	public:
+		using spec_type = typename spec<storagebuffer>;
+
+		template <class Desc = spec_type
+		> ML_NODISCARD static auto create(Desc && desc, allocator_type alloc = {}) noexcept
+		{
+			return ML_get_global(render_device)->new_storagebuffer(ML_forward(desc), alloc);
+		}
+
+	public:
+		explicit storagebuffer(render_device * parent) noexcept : render_object{ parent } {}
+
+		virtual ~storagebuffer() override = default;
+
+		virtual bool revalue() = 0;
+
+		ML_NODISCARD virtual object_id get_handle() const noexcept override = 0;
+
+		ML_NODISCARD virtual typeof_t<> const & get_self_type() const noexcept override = 0;
+
+	public:
+		virtual void set_data(size_t size, addr_t data, size_t offset = 0) = 0;
+
+		// read back from the gpu, stalls until earlier writes have completed
+		virtual void get_data(size_t size, void * data, size_t offset = 0) const = 0;
+
+		ML_NODISCARD virtual size_t get_size() const noexcept = 0;
+
+		ML_NODISCARD virtual uint32 get_usage() const noexcept = 0;
+
+	public:
+		inline void bind(uint32 binding, size_t offset = 0, size_t size = 0) const noexcept
+		{
+			get_context()->bind_storagebuffer(this, binding, offset, size);
+		}
+
+		inline void unbind(uint32 binding) const noexcept
+		{
+			get_context()->bind_storagebuffer(nullptr, binding);
+		}
+	};
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
 // texture
 namespace ml::gfx
 {
@@ -695,6 +1137,9 @@ namespace ml::gfx
 		
 		ML_NODISCARD virtual texture_flags_ get_flags() const noexcept = 0;
 
+		// resident bindless handle, zero if unsupported, the texture is immutable while it has one
+		ML_NODISCARD virtual uint64 get_bindless_handle() = 0;
+
 	public:
 		inline void bind(uint32 slot = 0) const noexcept
 		{
@@ -799,6 +1244,87 @@ namespace ml::gfx
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
+// texture2d array
+namespace ml::gfx
+{
+	// texture2d array specification
+	template <> struct ML_NODISCARD spec<texture2d_array> final
+	{
+		vec2i			size	{};
+		uint32			layers	{ 1 };
+		texture_format	format	{ format_rgba };
+		texture_flags_	flags	{ texture_flags_default };
+		addr_t			data	{ nullptr }; // every layer, one after another
+	};
+
+	static void from_json(json const & j, spec<texture2d_array> & v)
+	{
+		j["size"	].get_to(v.size);
+		j["layers"	].get_to(v.layers);
+		j["format"	].get_to(v.format);
+		j["flags"	].get_to(v.flags);
+	}
+
+	static void to_json(json & j, spec<texture2d_array> const & v)
+	{
+		j["size"	] = v.size;
+		j["layers"	] = v.layers;
+		j["format"	] = v.format;
+		j["flags"	] = v.flags;
+	}
+
+
+	// base texture2d array, same sized layers sampled with one binding
+	struct ML_CORE_API texture2d_array : public texture
+	{
+	public:
+		using spec_type = typename spec<texture2d_array>;
+
+		template <class Desc = spec_type
+		> ML_NODISCARD static auto create(Desc && desc, allocator_type alloc = {}) noexcept
+		{
+			return ML_get_global(render_device)->new_texture2d_array(ML_forward(desc), alloc);
+		}
+
+	public:
+		explicit texture2d_array(render_device * parent) noexcept : texture{ parent } {}
+
+		virtual ~texture2d_array() override = default;
+
+		virtual bool revalue() = 0;
+
+		ML_NODISCARD virtual object_id get_handle() const noexcept override = 0;
+
+		ML_NODISCARD virtual typeof_t<> const & get_self_type() const noexcept override = 0;
+
+	public:
+		virtual void lock() override = 0;
+
+		virtual void unlock() override = 0;
+
+		// replace one layer, data must match the array's size and format
+		virtual void update(uint32 layer, addr_t data) = 0;
+
+		virtual void set_mipmapped(bool value) = 0;
+
+		virtual void set_repeated(bool value) = 0;
+
+		virtual void set_smooth(bool value) = 0;
+
+		ML_NODISCARD inline uint32 get_type() const noexcept override { return texture_type_2d_array; }
+
+		ML_NODISCARD virtual uint32 get_layers() const noexcept = 0;
+
+		ML_NODISCARD virtual vec2i const & get_size() const noexcept = 0;
+
+		ML_NODISCARD virtual texture_format const & get_format() const noexcept = 0;
+
+		ML_NODISCARD virtual texture_flags_ get_flags() const noexcept = 0;
+	};
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
 // texture3d (WIP)
 namespace ml::gfx
 {
@@ -1032,6 +1558,35 @@ namespace ml::gfx
 	{
 	};
 
+	// program status
+	enum program_status_ : uint32
+	{
+		program_status_none,		// not linked
+		program_status_compiling,	// submitted, not finished
+		program_status_ready,		// linked
+		program_status_failed,		// compile or link failed
+	};
+
+	// uniform block member layout, as reported by the linker
+	struct ML_NODISCARD uniform_block_member final
+	{
+		uint32 offset		; // byte offset in block
+		uint32 array_size	; // element count
+		uint32 array_stride	; // bytes between elements
+		uint32 matrix_stride; // bytes between matrix columns
+		uint32 size			; // bytes in one element without padding, zero if unknown
+	};
+
+	// uniform block layout
+	struct ML_NODISCARD uniform_block final
+	{
+		uint32 index	; // block index
+		uint32 binding	; // buffer binding
+		uint32 size		; // data size
+
+		flat_map<hash_t, uniform_block_member> members; // members by name
+	};
+
 	// base program
 	struct ML_CORE_API program : public render_object<program>
 	{
@@ -1076,6 +1631,32 @@ namespace ml::gfx
 
 		virtual bool link() = 0;
 
+		// compile without waiting, errors are reported by the link
+		virtual void attach_async(uint32 type, size_t count, cstring * str, int32 const * len = nullptr) = 0;
+
+		inline void attach_async(uint32 type, string const & str) noexcept
+		{
+			if (str.empty()) { return; }
+			cstring temp{ str.c_str() };
+			attach_async(type, 1, &temp, nullptr);
+		}
+
+		// link without waiting, poll until the status is no longer compiling
+		virtual void link_async() = 0;
+
+		// check a compiling program without blocking, returns the new status
+		virtual uint32 poll() = 0;
+
+		ML_NODISCARD virtual uint32 get_status() const noexcept = 0;
+
+		ML_NODISCARD inline bool ready() const noexcept { return get_status() == program_status_ready; }
+
+		// driver specific image of the linked program, false if there is none
+		virtual bool get_binary(uint32 & format, list<byte> & data) const = 0;
+
+		// link from an image returned by get_binary, false if the driver rejects it
+		virtual bool load_binary(uint32 format, addr_t data, size_t size) = 0;
+
 		virtual bool bind_uniform(cstring name, method<void(uniform_id)> const & fn) = 0;
 
 		ML_NODISCARD virtual uniform_id get_uniform_location(cstring name) noexcept = 0;
@@ -1088,10 +1669,45 @@ namespace ml::gfx
 
 		ML_NODISCARD virtual flat_map<uniform_id, ref<texture>> const & get_textures() const noexcept = 0;
 
+		// reflection is published with the ready status, only read it once ready
 		ML_NODISCARD virtual flat_map<hash_t, uniform_id> const & get_uniforms() const noexcept = 0;
 
+		ML_NODISCARD virtual flat_map<hash_t, uniform_block> const & get_uniform_blocks() const noexcept = 0;
+
+		// assign a uniform block to a buffer binding
+		virtual bool bind_uniform_block(cstring name, uint32 binding) = 0;
+
+		ML_NODISCARD inline uniform_block const * get_uniform_block(cstring name) const noexcept
+		{
+			if (auto const it{ get_uniform_blocks().find(hashof(name, std::strlen(name))) })
+			{
+				return &(*it->second);
+			}
+			return nullptr;
+		}
+
 		ML_NODISCARD virtual uint32 get_mask() const noexcept = 0;
 
+	public:
+		// upload directly to this program, it does not need to be bound
+		virtual void upload(uniform_id loc, bool value) = 0;
+
+		virtual void upload(uniform_id loc, int32 value) = 0;
+
+		virtual void upload(uniform_id loc, float32 value) = 0;
+
+		virtual void upload(uniform_id loc, vec2f const & value) = 0;
+
+		virtual void upload(uniform_id loc, vec3f const & value) = 0;
+
+		virtual void upload(uniform_id loc, vec4f const & value) = 0;
+
+		virtual void upload(uniform_id loc, mat2f const & value) = 0;
+
+		virtual void upload(uniform_id loc, mat3f const & value) = 0;
+
+		virtual void upload(uniform_id loc, mat4f const & value) = 0;
+
 	public:
 		inline void bind() const noexcept
 		{
@@ -1125,7 +1741,7 @@ namespace ml::gfx
 				}
 				else
 				{
-					get_context()->upload(loc, ML_forward(value));
+					upload(loc, ML_forward(value));
 				}
 			});
 		}
@@ -1150,6 +1766,7 @@ namespace ml::gfx
 		shader_bit_geometry		= 4,
 		shader_bit_tess_ctrl	= 8,
 		shader_bit_tess_eval	= 10,
+		shader_bit_compute		= 32,
 		shader_bit_all			= 0xffffffff
 	};
 
@@ -1275,4 +1892,89 @@ namespace ml::gfx
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
+// pipeline state
+namespace ml::gfx
+{
+	// pipeline state specification
+	template <> struct ML_NODISCARD spec<pipeline_state> final
+	{
+		alpha_state		alpha	{}; // alpha test
+		blend_state		blend	{}; // blending
+		cull_state		cull	{}; // face culling
+		depth_state		depth	{}; // depth test
+		stencil_state	stencil	{}; // stencil test
+		ref<program>	program	{}; // program
+		buffer_layout	layout	{}; // vertex layout
+	};
+
+	// hashes of each part of a pipeline state, equal hashes are treated as equal state
+	struct ML_NODISCARD pipeline_hash final
+	{
+		hash_t alpha	; // alpha state
+		hash_t blend	; // blend state
+		hash_t cull		; // cull state
+		hash_t depth	; // depth state
+		hash_t stencil	; // stencil state
+		hash_t layout	; // vertex layout
+		hash_t value	; // all parts and program
+	};
+
+	// base pipeline state, immutable once created
+	struct ML_CORE_API pipeline_state : public render_object<pipeline_state>
+	{
+	public:
+		using spec_type = typename spec<pipeline_state>;
+
+		template <class Desc = spec_type
+		> ML_NODISCARD static auto create(Desc && desc, allocator_type alloc = {}) noexcept
+		{
+			return ML_get_global(render_device)->new_pipeline_state(ML_forward(desc), alloc);
+		}
+
+		ML_NODISCARD static pipeline_hash make_hash(spec_type const & desc) noexcept
+		{
+			pipeline_hash h{};
+			h.alpha		= hash_state(desc.alpha);
+			h.blend		= hash_state(desc.blend);
+			h.cull		= hash_state(desc.cull);
+			h.depth		= hash_state(desc.depth);
+			h.stencil	= hash_state(desc.stencil);
+			h.layout	= hash_layout(desc.layout);
+			h.value		= hash_fields(fnv1a_basis, h.alpha, h.blend, h.cull, h.depth, h.stencil, h.layout, (intptr_t)desc.program.get());
+			return h;
+		}
+
+	public:
+		explicit pipeline_state(render_device * parent) noexcept : render_object{ parent } {}
+
+		virtual ~pipeline_state() override = default;
+
+		ML_NODISCARD virtual object_id get_handle() const noexcept override = 0;
+
+		ML_NODISCARD virtual typeof_t<> const & get_self_type() const noexcept override = 0;
+
+	public:
+		ML_NODISCARD virtual spec_type const & get_spec() const noexcept = 0;
+
+		ML_NODISCARD virtual pipeline_hash const & get_hash() const noexcept = 0;
+
+	public:
+		ML_NODISCARD inline auto get_alpha_state() const noexcept -> alpha_state const & { return get_spec().alpha; }
+
+		ML_NODISCARD inline auto get_blend_state() const noexcept -> blend_state const & { return get_spec().blend; }
+
+		ML_NODISCARD inline auto get_cull_state() const noexcept -> cull_state const & { return get_spec().cull; }
+
+		ML_NODISCARD inline auto get_depth_state() const noexcept -> depth_state const & { return get_spec().depth; }
+
+		ML_NODISCARD inline auto get_stencil_state() const noexcept -> stencil_state const & { return get_spec().stencil; }
+
+		ML_NODISCARD inline auto get_program() const noexcept -> ref<program> const & { return get_spec().program; }
+
+		ML_NODISCARD inline auto get_layout() const noexcept -> buffer_layout const & { return get_spec().layout; }
+	};
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
 #endif // !_ML_RENDER_API_HPP_
\ No newline at end of file
@@ -72,7 +72,8 @@ namespace ml::gfx
 
 		ML_NODISCARD static command draw(ref<vertexarray> const & value) noexcept
 		{
-			return std::bind(&render_context::draw, std::placeholders::_1, value);
+			return std::bind(static_cast<void(render_context:: *)(ref<vertexarray> const &)
+			>(&render_context::draw), std::placeholders::_1, value);
 		}
 
 		ML_NODISCARD static command draw_arrays(uint32 mode, uint32 first, size_t count) noexcept
@@ -85,6 +86,27 @@ namespace ml::gfx
 			return std::bind(&render_context::draw_indexed, std::placeholders::_1, mode, count);
 		}
 
+		ML_NODISCARD static command draw_instanced(ref<vertexarray> const & value, size_t instances, size_t first_instance = 0) noexcept
+		{
+			return std::bind(static_cast<void(render_context:: *)(ref<vertexarray> const &, size_t, size_t)
+			>(&render_context::draw_instanced), std::placeholders::_1, value, instances, first_instance);
+		}
+
+		ML_NODISCARD static command draw_arrays_instanced(uint32 mode, size_t first, size_t count, size_t instances, size_t first_instance = 0) noexcept
+		{
+			return std::bind(&render_context::draw_arrays_instanced, std::placeholders::_1, mode, first, count, instances, first_instance);
+		}
+
+		ML_NODISCARD static command draw_indexed_instanced(uint32 mode, size_t count, size_t instances, size_t first_instance = 0) noexcept
+		{
+			return std::bind(&render_context::draw_indexed_instanced, std::placeholders::_1, mode, count, instances, first_instance);
+		}
+
+		ML_NODISCARD static command draw_indexed_indirect(uint32 mode, ref<streambuffer> const & buffer, size_t offset, size_t count) noexcept
+		{
+			return [=](render_context * ctx) { ctx->draw_indexed_indirect(mode, buffer.get(), offset, count); };
+		}
+
 		ML_NODISCARD static command flush() noexcept
 		{
 			return std::bind(&render_context::flush, std::placeholders::_1);
@@ -92,6 +114,23 @@ namespace ml::gfx
 
 		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
+		ML_NODISCARD static command dispatch(uint32 x, uint32 y = 1, uint32 z = 1) noexcept
+		{
+			return std::bind(&render_context::dispatch, std::placeholders::_1, x, y, z);
+		}
+
+		ML_NODISCARD static command dispatch_indirect(ref<storagebuffer> const & buffer, size_t offset = 0) noexcept
+		{
+			return [=](render_context * ctx) { ctx->dispatch_indirect(buffer.get(), offset); };
+		}
+
+		ML_NODISCARD static command memory_barrier(uint32 mask = barrier_flags_all) noexcept
+		{
+			return std::bind(&render_context::memory_barrier, std::placeholders::_1, mask);
+		}
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
 		template <class Value
 		> ML_NODISCARD static command bind_vertexarray(Value && value) noexcept
 		{
@@ -136,11 +175,50 @@ namespace ml::gfx
 		{
 			if constexpr (std::is_scalar_v<std::decay_t<decltype(value)>>)
 			{
-				return std::bind(&render_context::bind_texture, std::placeholders::_1, (texture *)value);
+				return std::bind(&render_context::bind_texture, std::placeholders::_1, (texture *)value, slot);
 			}
 			else
 			{
-				return std::bind(&render_context::bind_texture, std::placeholders::_1, (texture *)value.get());
+				return std::bind(&render_context::bind_texture, std::placeholders::_1, (texture *)value.get(), slot);
+			}
+		}
+
+		template <class Value
+		> ML_NODISCARD static command bind_uniformbuffer(Value && value, uint32 binding, size_t offset = 0, size_t size = 0) noexcept
+		{
+			if constexpr (std::is_scalar_v<std::decay_t<decltype(value)>>)
+			{
+				return std::bind(&render_context::bind_uniformbuffer, std::placeholders::_1, (uniformbuffer *)value, binding, offset, size);
+			}
+			else
+			{
+				return std::bind(&render_context::bind_uniformbuffer, std::placeholders::_1, (uniformbuffer *)value.get(), binding, offset, size);
+			}
+		}
+
+		template <class Value
+		> ML_NODISCARD static command bind_storagebuffer(Value && value, uint32 binding, size_t offset = 0, size_t size = 0) noexcept
+		{
+			if constexpr (std::is_scalar_v<std::decay_t<decltype(value)>>)
+			{
+				return std::bind(&render_context::bind_storagebuffer, std::placeholders::_1, (storagebuffer *)value, binding, offset, size);
+			}
+			else
+			{
+				return std::bind(&render_context::bind_storagebuffer, std::placeholders::_1, (storagebuffer *)value.get(), binding, offset, size);
+			}
+		}
+
+		template <class Value
+		> ML_NODISCARD static command bind_image(Value && value, uint32 unit, uint32 access = image_access_read_write, uint32 level = 0) noexcept
+		{
+			if constexpr (std::is_scalar_v<std::decay_t<decltype(value)>>)
+			{
+				return std::bind(&render_context::bind_image, std::placeholders::_1, (texture *)value, unit, access, level);
+			}
+			else
+			{
+				return std::bind(&render_context::bind_image, std::placeholders::_1, (texture *)value.get(), unit, access, level);
 			}
 		}
 
@@ -183,6 +261,19 @@ namespace ml::gfx
 			}
 		}
 
+		template <class Value
+		> ML_NODISCARD static command bind_pipeline_state(Value && value) noexcept
+		{
+			if constexpr (std::is_scalar_v<std::decay_t<decltype(value)>>)
+			{
+				return std::bind(&render_context::bind_pipeline_state, std::placeholders::_1, (pipeline_state *)value);
+			}
+			else
+			{
+				return std::bind(&render_context::bind_pipeline_state, std::placeholders::_1, (pipeline_state *)value.get());
+			}
+		}
+
 		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 		template <class T
@@ -14,6 +14,10 @@ namespace ml::gfx
 
 	ML_decl_handle(uniform_id); // uniform location
 
+	ML_decl_handle(sync_id); // fence handle
+
+	ML_decl_handle(query_id); // query handle
+
 	ML_alias addr_t = typename void const *; // data address
 	
 	ML_alias buffer_t = typename list<byte>; // byte buffer
@@ -205,6 +209,17 @@ namespace ml::gfx
 
 		format_depth_stencil,
 		format_depth24_stencil8,
+
+		format_rg,
+		format_r8,
+		format_rg8,
+		format_rgba8,
+		format_r16f,
+		format_rg16f,
+		format_rgba16f,
+		format_r32f,
+		format_rg32f,
+		format_rgba32f,
 	};
 
 	constexpr cstring format_NAMES[] =
@@ -229,6 +244,17 @@ namespace ml::gfx
 
 		"depth stencil",
 		"depth24 stencil8",
+
+		"rg",
+		"r8",
+		"rg8",
+		"rgba8",
+		"r16f",
+		"rg16f",
+		"rgba16f",
+		"r32f",
+		"rg32f",
+		"rgba32f",
 	};
 
 	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
@@ -297,6 +323,22 @@ namespace ml::gfx
 		"fill",
 	};
 
+	// primitives assembled from count vertices
+	ML_NODISCARD constexpr uint64 get_primitive_count(uint32 prim, size_t count) noexcept
+	{
+		switch (prim)
+		{
+		default							: return 0;
+		case primitive_points			: return count;
+		case primitive_lines			: return count / 2;
+		case primitive_line_loop		: return (1 < count) ? count : 0;
+		case primitive_line_strip		: return (1 < count) ? count - 1 : 0;
+		case primitive_triangles		: return count / 3;
+		case primitive_triangle_strip	:
+		case primitive_triangle_fan		: return (2 < count) ? count - 2 : 0;
+		}
+	}
+
 	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 	enum shader_type_ : uint32
@@ -304,6 +346,7 @@ namespace ml::gfx
 		shader_type_vertex,
 		shader_type_pixel,
 		shader_type_geometry,
+		shader_type_compute,
 
 		shader_type_MAX,
 	};
@@ -313,6 +356,7 @@ namespace ml::gfx
 		"vertex",
 		"pixel",
 		"geometry",
+		"compute",
 	};
 
 	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
@@ -324,6 +368,7 @@ namespace ml::gfx
 		texture_type_2d,
 		texture_type_3d,
 		texture_type_cube,
+		texture_type_2d_array,
 
 		texture_type_MAX,
 	};
@@ -335,6 +380,7 @@ namespace ml::gfx
 		"texture2d",
 		"texture3d",
 		"texturecube",
+		"texture2d_array",
 	};
 
 	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
@@ -384,6 +430,94 @@ namespace ml::gfx
 	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 }
 
+// packed
+namespace ml::gfx
+{
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	// half precision float, stored as its bits
+	struct ML_NODISCARD float16 final { uint16 bits; };
+
+	// signed normalized x, y, z in ten bits each and w in two, INT_2_10_10_10_REV
+	struct ML_NODISCARD packed_2_10_10_10 final { uint32 bits; };
+
+	ML_alias vec2h		= typename array<float16, 2>;
+	ML_alias vec4h		= typename array<float16, 4>;
+	ML_alias vec4i8		= typename tvec4<int8>;
+	ML_alias vec2i16	= typename tvec2<int16>;
+	ML_alias vec4i16	= typename tvec4<int16>;
+
+	static_assert(sizeof(vec2h) == 4 && sizeof(vec4h) == 8);
+	static_assert(sizeof(vec4i8) == 4 && sizeof(vec2i16) == 4 && sizeof(vec4i16) == 8);
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	// round to nearest half, out of range values become infinity
+	ML_NODISCARD inline float16 pack_half(float32 value) noexcept
+	{
+		uint32 x; std::memcpy(&x, &value, sizeof(x));
+
+		uint32 const sign{ (x >> 16) & 0x8000u };
+		uint32 const bits{ (x >> 23) & 0xffu };
+		uint32 mant{ x & 0x7fffffu };
+		int32 const exp{ (int32)bits - 127 + 15 };
+
+		if (bits == 0xffu) { return { (uint16)(sign | 0x7c00u | (mant ? 0x200u : 0u)) }; } // inf / nan
+
+		if (exp >= 31) { return { (uint16)(sign | 0x7c00u) }; } // overflow
+
+		if (exp <= 0) // subnormal
+		{
+			if (exp < -10) { return { (uint16)sign }; }
+
+			mant |= 0x800000u;
+			uint32 const shift{ (uint32)(14 - exp) };
+			uint32 const h{ (mant >> shift) + ((mant >> (shift - 1)) & 1u) };
+			return { (uint16)(sign | h) };
+		}
+
+		// a carry out of the mantissa correctly bumps the exponent
+		uint32 const h{ sign | ((uint32)exp << 10) | (mant >> 13) };
+		return { (uint16)(h + ((mant >> 12) & 1u)) };
+	}
+
+	ML_NODISCARD inline vec2h pack_half(vec2 const & value) noexcept
+	{
+		return { pack_half(value[0]), pack_half(value[1]) };
+	}
+
+	ML_NODISCARD inline vec4h pack_half(vec4 const & value) noexcept
+	{
+		return { pack_half(value[0]), pack_half(value[1]), pack_half(value[2]), pack_half(value[3]) };
+	}
+
+	// [-1, 1] to a normalized signed integer
+	template <class T
+	> ML_NODISCARD T pack_snorm(float32 value) noexcept
+	{
+		static_assert(std::is_integral_v<T> && std::is_signed_v<T>);
+
+		constexpr float32 scale{ (float32)(std::numeric_limits<T>::max)() };
+
+		return (T)std::round(std::clamp(value, -1.f, 1.f) * scale);
+	}
+
+	// [-1, 1] xyz and w to a 2_10_10_10 word
+	ML_NODISCARD inline packed_2_10_10_10 pack_snorm_2_10_10_10(vec3 const & value, float32 w = 0.f) noexcept
+	{
+		auto const component = [](float32 v, float32 scale, uint32 mask) noexcept
+		{
+			return (uint32)(int32)std::round(std::clamp(v, -1.f, 1.f) * scale) & mask;
+		};
+		return { component(value[0], 511.f, 0x3ffu)
+			| (component(value[1], 511.f, 0x3ffu) << 10)
+			| (component(value[2], 511.f, 0x3ffu) << 20)
+			| (component(w, 1.f, 0x3u) << 30) };
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+}
+
 // util
 namespace ml::gfx
 {
@@ -398,6 +532,85 @@ namespace ml::gfx
 			: buffer_t{ count * sizeof(Elem), (byte)0, alloc };
 	}
 
+	// channels in a pixel format
+	ML_NODISCARD constexpr size_t get_format_channels(uint32 value) noexcept
+	{
+		switch (value)
+		{
+		default							: return 1;
+		case format_rgb					:
+		case format_srgb				:
+		case format_srgb8				: return 3;
+		case format_rgba				:
+		case format_srgb_alpha			:
+		case format_srgb8_alpha8		:
+		case format_rgba8				:
+		case format_rgba16f				:
+		case format_rgba32f				: return 4;
+		case format_luminance_alpha		:
+		case format_sluminance_alpha	:
+		case format_sluminance8_alpha8	:
+		case format_rg					:
+		case format_rg8					:
+		case format_rg16f				:
+		case format_rg32f				: return 2;
+		}
+	}
+
+	// pixel transfer format of a sized format, others pass through
+	ML_NODISCARD constexpr uint32 get_base_format(uint32 value) noexcept
+	{
+		switch (value)
+		{
+		default				: return value;
+		case format_r8		:
+		case format_r16f	:
+		case format_r32f	: return format_red;
+		case format_rg8		:
+		case format_rg16f	:
+		case format_rg32f	: return format_rg;
+		case format_rgba8	:
+		case format_rgba16f	:
+		case format_rgba32f	: return format_rgba;
+		}
+	}
+
+	// image load/store needs a sized format
+	ML_NODISCARD constexpr bool is_image_format(uint32 value) noexcept
+	{
+		switch (value)
+		{
+		default				: return false;
+		case format_r8		:
+		case format_rg8		:
+		case format_rgba8	:
+		case format_r16f	:
+		case format_rg16f	:
+		case format_rgba16f	:
+		case format_r32f	:
+		case format_rg32f	:
+		case format_rgba32f	: return true;
+		}
+	}
+
+	// bytes per channel of a pixel type, packed types cover the whole pixel
+	ML_NODISCARD constexpr size_t get_type_size(uint32 value) noexcept
+	{
+		switch (value)
+		{
+		default					: return 0;
+		case type_byte			:
+		case type_ubyte			: return 1;
+		case type_short			:
+		case type_ushort		:
+		case type_half_float	: return 2;
+		case type_int			:
+		case type_uint			:
+		case type_float			:
+		case type_uint_24_8		: return 4;
+		}
+	}
+
 	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 	ML_NODISCARD constexpr uint32 calc_channel_format(size_t value) noexcept
@@ -445,6 +658,12 @@ namespace ml::gfx
 		case hashof_v<mat2f>	:
 		case hashof_v<mat3f>	:
 		case hashof_v<mat4f>	: return hashof_v<float32>;
+		case hashof_v<vec2h>	:
+		case hashof_v<vec4h>	: return hashof_v<float16>;
+		case hashof_v<vec4i8>	: return hashof_v<int8>;
+		case hashof_v<vec2i16>	:
+		case hashof_v<vec4i16>	: return hashof_v<int16>;
+		case hashof_v<packed_2_10_10_10>: return hashof_v<packed_2_10_10_10>;
 		}
 	}
 
@@ -465,11 +684,17 @@ namespace ml::gfx
 		case hashof_v<int32>	:
 		case hashof_v<float32>	: return 1;
 		case hashof_v<vec2i>	:
-		case hashof_v<vec2f>	: return 2;
+		case hashof_v<vec2f>	:
+		case hashof_v<vec2h>	:
+		case hashof_v<vec2i16>	: return 2;
 		case hashof_v<vec3i>	:
 		case hashof_v<vec3f>	: return 3;
 		case hashof_v<vec4i>	:
-		case hashof_v<vec4f>	: return 4;
+		case hashof_v<vec4f>	:
+		case hashof_v<vec4h>	:
+		case hashof_v<vec4i8>	:
+		case hashof_v<vec4i16>	:
+		case hashof_v<packed_2_10_10_10>: return 4;
 		case hashof_v<mat2i>	:
 		case hashof_v<mat2f>	: return 2 * 2;
 		case hashof_v<mat3i>	:
@@ -485,6 +710,28 @@ namespace ml::gfx
 	}
 
 	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	// get element column count, matrices take one attribute per column
+	ML_NODISCARD constexpr uint32 get_element_column_count(hash_t type) noexcept
+	{
+		switch (type)
+		{
+		default					: return 1;
+		case hashof_v<mat2i>	:
+		case hashof_v<mat2f>	: return 2;
+		case hashof_v<mat3i>	:
+		case hashof_v<mat3f>	: return 3;
+		case hashof_v<mat4i>	:
+		case hashof_v<mat4f>	: return 4;
+		}
+	}
+
+	template <class T> ML_NODISCARD constexpr uint32 get_element_column_count() noexcept
+	{
+		return _ML gfx::get_element_column_count(hashof_v<T>);
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 }
 
 // layout
@@ -501,7 +748,8 @@ namespace ml::gfx
 			util::is_any_of_v<T,
 				bool,
 				int32, vec2i, vec3i, vec4i, mat2i, mat3i, mat4i,
-				float32, vec2f, vec3f, vec4f, mat2f, mat3f, mat4f
+				float32, vec2f, vec3f, vec4f, mat2f, mat3f, mat4f,
+				vec2h, vec4h, vec4i8, vec2i16, vec4i16, packed_2_10_10_10
 			>
 		};
 
@@ -510,15 +758,16 @@ namespace ml::gfx
 		uint32		size		{};
 		bool		normalized	{};
 		uint32		offset		{};
+		uint32		divisor		{}; // instances per element, zero is per vertex
 
-		buffer_element(string const & name, hash_t type, uint32 size, bool normalized) noexcept
-			: name{ name }, type{ type }, size{ size }, normalized{ normalized }, offset{}
+		buffer_element(string const & name, hash_t type, uint32 size, bool normalized, uint32 divisor = 0) noexcept
+			: name{ name }, type{ type }, size{ size }, normalized{ normalized }, offset{}, divisor{ divisor }
 		{
 		}
 
 		template <class Elem
-		> buffer_element(Elem, cstring name, bool normalized = false) noexcept
-			: buffer_element{ name, hashof_v<Elem>, sizeof(Elem), normalized }
+		> buffer_element(Elem, cstring name, bool normalized = false, uint32 divisor = 0) noexcept
+			: buffer_element{ name, hashof_v<Elem>, sizeof(Elem), normalized, divisor }
 		{
 			static_assert(is_valid_type<Elem>);
 		}
@@ -532,6 +781,11 @@ namespace ml::gfx
 		{
 			return _ML gfx::get_element_component_count(type);
 		}
+
+		ML_NODISCARD uint32 get_column_count() const noexcept
+		{
+			return _ML gfx::get_element_column_count(type);
+		}
 	};
 
 	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
@@ -581,12 +835,69 @@ namespace ml::gfx
 
 		ML_NODISCARD auto stride() const noexcept -> uint32 { return m_stride; }
 
+		// number of attribute locations used
+		ML_NODISCARD auto location_count() const noexcept -> uint32
+		{
+			uint32 count{};
+			for (auto const & e : m_elements) { count += e.get_column_count(); }
+			return count;
+		}
+
 	private:
 		uint32			m_stride	{}; // stride
 		storage_type	m_elements	{}; // elements
 	};
 	
 	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	// fold the bytes of each value into a running hash, values must not contain padding
+	template <class ... Ts
+	> ML_NODISCARD hash_t hash_fields(hash_t seed, Ts const & ... values) noexcept
+	{
+		((seed = fnv1a_hash(reinterpret_cast<uint8 const *>(&values), sizeof(Ts), seed)), ...);
+		return seed;
+	}
+
+	// hash of everything that affects how a layout is read
+	ML_NODISCARD inline hash_t hash_layout(buffer_layout const & value) noexcept
+	{
+		hash_t seed{ hash_fields(fnv1a_basis, value.stride()) };
+		for (buffer_element const & e : value.elements())
+		{
+			seed = hash_fields(seed, hashof(e.name), e.type, e.size, (uint32)e.normalized, e.offset, e.divisor);
+		}
+		return seed;
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+}
+
+// indirect
+namespace ml::gfx
+{
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	// indexed indirect draw, layout matches what the driver reads
+	struct ML_NODISCARD draw_indirect_command final
+	{
+		uint32 count			; // index count
+		uint32 instance_count	; // instance count
+		uint32 first_index		; // first index
+		int32  base_vertex		; // added to each index
+		uint32 base_instance	; // first instance
+	};
+
+	static_assert(sizeof(draw_indirect_command) == 5 * sizeof(uint32));
+
+	// indirect dispatch, work group counts
+	struct ML_NODISCARD dispatch_indirect_command final
+	{
+		uint32 x, y, z;
+	};
+
+	static_assert(sizeof(dispatch_indirect_command) == 3 * sizeof(uint32));
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 }
 
 // states
@@ -611,6 +922,36 @@ namespace ml::gfx
 
 	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
+	// barrier flags, what shader writes must be visible to
+	enum barrier_flags_ : uint32
+	{
+		barrier_flags_none			= 0,		// nothing
+		barrier_flags_vertices		= 1 << 0,	// vertex attributes
+		barrier_flags_indices		= 1 << 1,	// index fetches
+		barrier_flags_uniforms		= 1 << 2,	// uniform blocks
+		barrier_flags_textures		= 1 << 3,	// texture sampling
+		barrier_flags_images		= 1 << 4,	// image load/store
+		barrier_flags_commands		= 1 << 5,	// indirect draws and dispatches
+		barrier_flags_buffers		= 1 << 6,	// buffer updates and readback
+		barrier_flags_framebuffer	= 1 << 7,	// framebuffer attachments
+		barrier_flags_storage		= 1 << 8,	// storage buffers
+
+		// everything
+		barrier_flags_all = 0xffffffff,
+	};
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	// image access
+	enum image_access_ : uint32
+	{
+		image_access_read,
+		image_access_write,
+		image_access_read_write,
+	};
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
 	// alpha state
 	struct ML_NODISCARD alpha_state final
 	{
@@ -670,6 +1011,39 @@ namespace ml::gfx
 	};
 
 	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	// state hashes, fields are hashed one by one so padding is never read
+
+	ML_NODISCARD inline hash_t hash_state(alpha_state const & value) noexcept
+	{
+		return hash_fields(fnv1a_basis, (uint32)value.enabled, value.pred, value.ref);
+	}
+
+	ML_NODISCARD inline hash_t hash_state(blend_state const & value) noexcept
+	{
+		return hash_fields(fnv1a_basis, (uint32)value.enabled, value.color.rgba(),
+			value.color_equation, value.color_sfactor, value.color_dfactor,
+			value.alpha_equation, value.alpha_sfactor, value.alpha_dfactor);
+	}
+
+	ML_NODISCARD inline hash_t hash_state(cull_state const & value) noexcept
+	{
+		return hash_fields(fnv1a_basis, (uint32)value.enabled, value.facet, value.order);
+	}
+
+	ML_NODISCARD inline hash_t hash_state(depth_state const & value) noexcept
+	{
+		return hash_fields(fnv1a_basis, (uint32)value.enabled, value.pred, value.range);
+	}
+
+	ML_NODISCARD inline hash_t hash_state(stencil_state const & value) noexcept
+	{
+		return hash_fields(fnv1a_basis, (uint32)value.enabled,
+			value.front_pred, value.front_ref, value.front_mask,
+			value.back_pred, value.back_ref, value.back_mask);
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 }
 
 #endif // !_ML_RENDER_ENUM_HPP_
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include <modus_core/graphics/Shader.hpp>
+#include <modus_core/graphics/ProgramCache.hpp>
 
 #ifdef ML_IMPL_RENDERER_OPENGL
 #include <modus_core/backends/opengl/OpenGL_Shader.hpp>
@@ -35,6 +36,7 @@ namespace ml::gfx
 					case hashof("vertex")	: dst = &src[shader_type_vertex]; break;
 					case hashof("pixel")	: dst = &src[shader_type_pixel]; break;
 					case hashof("geometry")	: dst = &src[shader_type_geometry]; break;
+					case hashof("compute")	: dst = &src[shader_type_compute]; break;
 					}
 				}
 				else
@@ -61,6 +63,72 @@ namespace ml::gfx
 
 	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 	
+	ref<program> make_program(program_source const & src)
+	{
+		if (program_cache * const cache{ ML_get_global(program_cache) })
+		{
+			return cache->load(src);
+		}
+
+		ref<program> ptr{ program::create({}) };
+
+		for (size_t i = 0; i < src.size(); ++i)
+		{
+			if (src[i]) { ptr->attach((uint32)i, *src[i]); }
+		}
+
+		if (!ptr->link()) { debug::warn(ptr->get_info_log()); return nullptr; }
+
+		return ptr;
+	}
+
+	ref<program> make_program_async(program_source const & src)
+	{
+		if (program_cache * const cache{ ML_get_global(program_cache) })
+		{
+			return cache->load_async(src);
+		}
+
+		ref<program> ptr{ program::create({}) };
+
+		for (size_t i = 0; i < src.size(); ++i)
+		{
+			if (src[i]) { ptr->attach_async((uint32)i, *src[i]); }
+		}
+
+		ptr->link_async();
+
+		return ptr;
+	}
+
+	ref<program> make_fallback_program()
+	{
+		program_source src{};
+
+		src[shader_type_vertex] = R"(#version 420 core
+layout(location = 0) in vec3 a_position;
+layout(location = 3) in mat4 a_model;
+layout(std140, binding = 0) uniform frame_block {
+	mat4 u_view;
+	mat4 u_proj;
+};
+void main()
+{
+	gl_Position = (u_proj * u_view * a_model) * vec4(a_position, 1.0);
+}
+)";
+		src[shader_type_pixel] = R"(#version 420 core
+out vec4 o_color;
+void main()
+{
+	o_color = vec4(1.0, 0.0, 1.0, 1.0);
+}
+)";
+		return make_program(src);
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
 	std::ostream & shader_builder::emit_source(std::ostream & out, json const & in)
 	{
 		return impl_builder::emit_source(out, in);
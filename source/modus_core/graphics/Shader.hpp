@@ -39,21 +39,15 @@ namespace ml::gfx
 
 	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
+	// make program, through the global program cache when there is one
+	ML_CORE_API ref<program> make_program(program_source const & src);
+
 	// parse program
 	template <class In> ref<program> parse_program(In && in)
 	{
 		if (program_source src{}; _ML gfx::parse_source(ML_forward(in), src))
 		{
-			ref<program> ptr{ program::create({}) };
-			
-			for (size_t i = 0; i < src.size(); ++i)
-			{
-				if (src[i]) { ptr->attach((uint32)i, *src[i]); }
-			}
-			
-			if (!ptr->link()) { debug::warn(ptr->get_info_log()); }
-			
-			return ptr;
+			return _ML gfx::make_program(src);
 		}
 		else
 		{
@@ -61,6 +55,26 @@ namespace ml::gfx
 		}
 	}
 
+	// make program without waiting for the compiler, the device polls it until ready
+	ML_CORE_API ref<program> make_program_async(program_source const & src);
+
+	// parse program without waiting for the compiler
+	template <class In> ref<program> parse_program_async(In && in)
+	{
+		if (program_source src{}; _ML gfx::parse_source(ML_forward(in), src))
+		{
+			return _ML gfx::make_program_async(src);
+		}
+		else
+		{
+			return nullptr;
+		}
+	}
+
+	// flat color program for the engine's vertex and frame block layout,
+	// bound in place of programs that are still compiling
+	ML_CORE_API ref<program> make_fallback_program();
+
 	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 	// shader builder
@@ -0,0 +1,123 @@
+#ifndef _ML_TEXTURE_TABLE_HPP_
+#define _ML_TEXTURE_TABLE_HPP_
+
+#include <modus_core/graphics/RenderAPI.hpp>
+
+// TEXTURE TABLE
+namespace ml
+{
+	// bindless handles of many textures in one uniform block, shaders index the
+	// table instead of having a texture bound to a slot for every draw
+	struct ML_NODISCARD texture_table final
+	{
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		using allocator_type = typename pmr::polymorphic_allocator<byte>;
+
+		enum : uint32 { invalid_index = static_cast<uint32>(-1) };
+
+		// std140 arrays pad every element out to a vec4
+		struct ML_NODISCARD entry final
+		{
+			uint64 handle, padding;
+		};
+
+		static constexpr size_t default_capacity{ 1024 };
+
+		texture_table(size_t capacity = default_capacity, allocator_type alloc = {}) noexcept
+			: m_buffer	{}
+			, m_textures{ alloc }
+			, m_entries	{ alloc }
+			, m_capacity{ (std::max)(capacity, (size_t)1) }
+			, m_dirty	{}
+		{
+			if (!is_available()) { return; }
+
+			m_buffer = gfx::uniformbuffer::create(gfx::spec<gfx::uniformbuffer>{
+				gfx::usage_dynamic, m_capacity * sizeof(entry), nullptr
+			});
+		}
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		// bindless handles need GL_ARB_bindless_texture, otherwise bind textures by slot
+		ML_NODISCARD static bool is_available() noexcept
+		{
+			return ML_get_global(gfx::render_device)->get_info().bindless_textures_available;
+		}
+
+		ML_NODISCARD auto get_buffer() const noexcept -> ref<gfx::uniformbuffer> const & { return m_buffer; }
+
+		ML_NODISCARD auto get_capacity() const noexcept -> size_t { return m_capacity; }
+
+		ML_NODISCARD auto size() const noexcept -> size_t { return m_textures.size(); }
+
+		ML_NODISCARD bool empty() const noexcept { return m_textures.empty(); }
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		// index of a texture in the table, added on first use
+		ML_NODISCARD uint32 add(ref<gfx::texture> const & value)
+		{
+			if (!value || !m_buffer) { return invalid_index; }
+
+			if (auto const it{ std::find(m_textures.begin(), m_textures.end(), value) }
+			; it != m_textures.end())
+			{
+				return (uint32)std::distance(m_textures.begin(), it);
+			}
+
+			if (m_capacity <= m_textures.size()) { return invalid_index; }
+
+			m_textures.push_back(value);
+
+			m_entries.push_back({ value->get_bindless_handle(), 0 });
+
+			m_dirty = true;
+
+			return (uint32)m_textures.size() - 1;
+		}
+
+		void clear() noexcept
+		{
+			m_textures.clear();
+			m_entries.clear();
+			m_dirty = true;
+		}
+
+		// copy handles added since the last upload
+		void upload()
+		{
+			if (!m_dirty || !m_buffer) { return; }
+
+			if (!m_entries.empty())
+			{
+				m_buffer->set_data(m_entries.size() * sizeof(entry), m_entries.data());
+			}
+
+			m_dirty = false;
+		}
+
+		void bind(gfx::render_context * ctx)
+		{
+			if (!m_buffer) { return; }
+
+			upload();
+
+			ctx->bind_uniformbuffer(m_buffer.get(), gfx::uniform_binding_textures);
+		}
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	private:
+		ref<gfx::uniformbuffer>		m_buffer	; // handle block
+		list<ref<gfx::texture>>		m_textures	; // textures by index
+		list<entry>					m_entries	; // handles by index
+		size_t						m_capacity	; // max textures
+		bool						m_dirty		; // changed since last upload
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+	};
+}
+
+#endif // !_ML_TEXTURE_TABLE_HPP_
\ No newline at end of file
@@ -0,0 +1,84 @@
+#ifndef _ML_GPU_PROFILER_PANEL_HPP_
+#define _ML_GPU_PROFILER_PANEL_HPP_
+
+#include <modus_core/graphics/GpuProfiler.hpp>
+#include <modus_core/gui/ImGui.hpp>
+
+namespace ml::ImGuiExt
+{
+	// GPU PROFILER PANEL
+	struct ML_NODISCARD GpuProfilerPanel final : non_copyable
+	{
+	public:
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		fs::path TracePath{ "gpu_trace.json" }; // export path
+
+		int32 CaptureFrames{ 300 }; // frames per capture
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		bool Draw(cstring title, gpu_profiler * profiler, bool * p_open = NULL, ImGuiWindowFlags flags = ImGuiWindowFlags_MenuBar)
+		{
+			bool const is_open{ ImGui::Begin(title, p_open, flags) };
+			if (is_open && profiler)
+			{
+				// menubar
+				if (ImGui::BeginMenuBar()) {
+					bool enabled{ profiler->is_enabled() };
+					if (ImGui::Checkbox("enabled", &enabled)) { profiler->set_enabled(enabled); }
+					ImGui::Separator();
+					if (profiler->is_capturing()) {
+						if (ImGui::MenuItem("stop capture")) { profiler->stop_capture(); }
+					}
+					else if (ImGui::MenuItem("capture")) {
+						profiler->start_capture((size_t)(std::max)(CaptureFrames, 1));
+					}
+					ImGui::Separator();
+					if (ImGui::MenuItem("save trace")) { profiler->save_trace(TracePath); }
+					ImGui::EndMenuBar();
+				}
+
+				DrawResults(profiler->get_results());
+			}
+			ImGui::End();
+			return is_open;
+		}
+
+		// one row per pass, indented by depth, bars are relative to the whole frame
+		void DrawResults(list<gpu_profiler::result> const & results)
+		{
+			if (results.empty()) { return ImGui::TextDisabled("no results"); }
+
+			float64 const frame_ms{ (std::max)(results.front().milliseconds(), 1e-6) };
+
+			ImGui::Text("frame %llu", (unsigned long long)results.front().frame);
+			ImGui::Separator();
+
+			ImGui::Columns(3, "##gpu_profiler_results");
+			ImGui::TextDisabled("pass"); ImGui::NextColumn();
+			ImGui::TextDisabled("ms"); ImGui::NextColumn();
+			ImGui::TextDisabled("%% frame"); ImGui::NextColumn();
+			ImGui::Separator();
+
+			for (gpu_profiler::result const & r : results)
+			{
+				float64 const ms{ r.milliseconds() };
+				ImGui::Indent((float32)r.depth * ImGui::GetStyle().IndentSpacing + 1.f);
+				ImGui::TextUnformatted(r.name.c_str());
+				ImGui::Unindent((float32)r.depth * ImGui::GetStyle().IndentSpacing + 1.f);
+				ImGui::NextColumn();
+				ImGui::Text("%.3f", ms);
+				ImGui::NextColumn();
+				ImGui::ProgressBar((float32)(ms / frame_ms), { -1.f, 0.f });
+				ImGui::NextColumn();
+			}
+
+			ImGui::Columns(1);
+		}
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+	};
+}
+
+#endif // !_ML_GPU_PROFILER_PANEL_HPP_
\ No newline at end of file
@@ -53,6 +53,15 @@ namespace ml
 #endif
 	}
 
+	bool ImGui_CreateDeviceObjects()
+	{
+#ifdef ML_IMPL_RENDERER_OPENGL
+		return ImGui_ImplOpenGL3_CreateDeviceObjects();
+#else
+		return false;
+#endif
+	}
+
 	void ImGui_RenderDrawData(ImDrawData * draw_data)
 	{
 #ifdef ML_IMPL_RENDERER_OPENGL
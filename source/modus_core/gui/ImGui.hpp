@@ -116,6 +116,8 @@ namespace ml
 
 	ML_CORE_API void ImGui_NewFrame();
 
+	ML_CORE_API bool ImGui_CreateDeviceObjects();
+
 	ML_CORE_API void ImGui_RenderDrawData(ImDrawData * draw_data);
 
 	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
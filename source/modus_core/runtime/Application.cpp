@@ -18,6 +18,7 @@ namespace ml
 			runtime_startup_event,
 			runtime_shutdown_event,
 			runtime_idle_event,
+			runtime_fixed_update_event,
 			dockspace_builder_event,
 			runtime_gui_event,
 			runtime_end_frame_event
@@ -44,6 +45,7 @@ namespace ml
 		case runtime_startup_event	::ID: { auto const & ev{ (runtime_startup_event const &)value }; } break;
 		case runtime_shutdown_event	::ID: { auto const & ev{ (runtime_shutdown_event const &)value }; } break;
 		case runtime_idle_event		::ID: { auto const & ev{ (runtime_idle_event const &)value }; } break;
+		case runtime_fixed_update_event::ID: { auto const & ev{ (runtime_fixed_update_event const &)value }; } break;
 		case dockspace_builder_event::ID: { auto const & ev{ (dockspace_builder_event const &)value }; } break;
 		case runtime_gui_event		::ID: { auto const & ev{ (runtime_gui_event const &)value }; } break;
 		case runtime_end_frame_event::ID: { auto const & ev{ (runtime_end_frame_event const &)value }; } break;
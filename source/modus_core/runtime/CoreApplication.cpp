@@ -22,6 +22,7 @@ namespace ml
 		, m_event_bus		{ alloc }
 		, m_libs			{ alloc }
 		, m_addons			{ &m_event_bus, alloc }
+		, m_jobs			{ argj.contains("job_workers") ? argj["job_workers"].get<size_t>() : 0 }
 	{
 		ML_ctor_global(core_application);
 
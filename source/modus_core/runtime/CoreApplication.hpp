@@ -3,6 +3,7 @@
 
 #include <modus_core/detail/Timer.hpp>
 #include <modus_core/embed/AddonManager.hpp>
+#include <modus_core/system/JobSystem.hpp>
 
 namespace ml
 {
@@ -55,6 +56,8 @@ namespace ml
 
 		ML_NODISCARD auto get_arguments(size_t i) const noexcept -> string const & { return m_arguments[i]; }
 
+		ML_NODISCARD auto get_jobs() const noexcept { return const_cast<job_system *>(&m_jobs); }
+
 		ML_NODISCARD auto get_attr() noexcept -> json & { return m_attributes; }
 
 		ML_NODISCARD auto get_attr() const noexcept -> json const & { return m_attributes; }
@@ -195,6 +198,7 @@ namespace ml
 		event_bus		m_event_bus		; // event bus
 		library_storage	m_libs			; // library manager
 		addon_manager	m_addons		; // addon manager
+		job_system		m_jobs			; // job system
 
 		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 	};
@@ -0,0 +1,197 @@
+#include <modus_core/runtime/FramePipeline.hpp>
+
+namespace ml
+{
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	void render_frame::clear() noexcept
+	{
+		release_objects();
+
+		for (ImDrawList * e : m_draw_lists) { IM_DELETE(e); }
+		m_draw_lists.clear();
+		m_draw_copy.Clear();
+
+		draw_data = nullptr;
+	}
+
+	void render_frame::release_objects() noexcept
+	{
+		commands.clear();
+
+		m_releases.clear();
+	}
+
+	void render_frame::reference_draw_data(ImDrawData * value) noexcept
+	{
+		draw_data = value;
+	}
+
+	void render_frame::capture_draw_data(ImDrawData const * value)
+	{
+		for (ImDrawList * e : m_draw_lists) { IM_DELETE(e); }
+		m_draw_lists.clear();
+		m_draw_copy.Clear();
+
+		if (!value || !value->Valid) { draw_data = nullptr; return; }
+
+		m_draw_lists.reserve((size_t)value->CmdListsCount);
+		for (int32 i = 0; i < value->CmdListsCount; ++i) {
+			m_draw_lists.push_back(value->CmdLists[i]->CloneOutput());
+		}
+
+		m_draw_copy					= *value;
+		m_draw_copy.CmdLists		= m_draw_lists.data();
+		m_draw_copy.CmdListsCount	= (int32)m_draw_lists.size();
+		m_draw_copy.OwnerViewport	= nullptr;
+
+		draw_data = &m_draw_copy;
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	frame_pipeline::frame_pipeline()
+		: m_pool		{ pmr::new_delete_resource() }
+		, m_window		{}
+		, m_render_fn	{}
+		, m_frames		{ render_frame{ &m_pool }, render_frame{ &m_pool }, render_frame{ &m_pool } }
+		, m_latency		{ 1 }
+		, m_build_index	{}
+		, m_render_index{}
+		, m_queued		{}
+		, m_jobs		{ &m_pool }
+		, m_jobs_pushed	{}
+		, m_jobs_done	{}
+		, m_thread		{}
+		, m_mutex		{}
+		, m_cv			{}
+		, m_quit		{}
+	{
+	}
+
+	frame_pipeline::~frame_pipeline() noexcept
+	{
+		stop();
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	bool frame_pipeline::start(window_handle window)
+	{
+		if (is_running() || !window || !m_render_fn) { return false; }
+
+		m_window = window;
+		m_render_index = m_build_index;
+		m_queued = 0;
+		m_quit = false;
+
+		// the context can only be current on one thread at a time
+		window_api::set_active_window(nullptr);
+
+		m_thread = std::thread{ &frame_pipeline::render_loop, this };
+
+		return true;
+	}
+
+	void frame_pipeline::stop()
+	{
+		if (!is_running()) { return; }
+		{
+			std::unique_lock<std::mutex> lock{ m_mutex };
+			m_quit = true;
+		}
+		m_cv.notify_all();
+		m_thread.join();
+
+		window_api::set_active_window(m_window);
+
+		// imgui copies were allocated here, so they are freed here
+		for (render_frame & e : m_frames) { e.clear(); }
+	}
+
+	void frame_pipeline::submit()
+	{
+		// serial
+		if (!is_running())
+		{
+			if (m_render_fn) { m_render_fn(get_build_frame()); }
+
+			return get_build_frame().clear();
+		}
+
+		// wait for room in the queue, the next slot has been rendered and released
+		{
+			std::unique_lock<std::mutex> lock{ m_mutex };
+			m_cv.wait(lock, [&]() noexcept { return m_queued < m_latency; });
+			m_build_index = (m_build_index + 1) % (m_latency + 1);
+			++m_queued;
+		}
+		m_cv.notify_all();
+	}
+
+	void frame_pipeline::dispatch(job_fn const & fn)
+	{
+		if (!fn) { return; }
+
+		// serial, or already on the render thread
+		if (!is_running() || is_render_thread()) { return fn(); }
+
+		std::unique_lock<std::mutex> lock{ m_mutex };
+		m_jobs.push_back(fn);
+		uint64 const ticket{ ++m_jobs_pushed };
+		m_cv.notify_all();
+		m_cv.wait(lock, [&]() noexcept { return ticket <= m_jobs_done; });
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	void frame_pipeline::render_loop()
+	{
+		window_api::set_active_window(m_window);
+		ML_defer(&) { window_api::set_active_window(nullptr); };
+
+		std::unique_lock<std::mutex> lock{ m_mutex };
+		while (true)
+		{
+			m_cv.wait(lock, [&]() noexcept { return m_queued || !m_jobs.empty() || m_quit; });
+
+			// jobs go first so resources they create exist for the next frame
+			run_jobs(lock);
+
+			// drain queued frames before quitting
+			if (!m_queued) { if (m_quit) { break; } continue; }
+
+			render_frame & frame{ m_frames[m_render_index] };
+			lock.unlock();
+
+			m_render_fn(frame);
+
+			// gfx objects the frame held are destroyed while the context is current,
+			// the imgui copy is freed by the main thread when it reuses the slot
+			frame.release_objects();
+
+			lock.lock();
+			m_render_index = (m_render_index + 1) % (m_latency + 1);
+			--m_queued;
+			m_cv.notify_all();
+		}
+	}
+
+	void frame_pipeline::run_jobs(std::unique_lock<std::mutex> & lock)
+	{
+		while (!m_jobs.empty())
+		{
+			list<job_fn> jobs{ std::move(m_jobs) };
+			m_jobs.clear();
+			lock.unlock();
+
+			for (job_fn const & fn : jobs) { fn(); }
+
+			lock.lock();
+			m_jobs_done += jobs.size();
+			m_cv.notify_all();
+		}
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+}
\ No newline at end of file
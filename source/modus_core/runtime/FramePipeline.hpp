@@ -0,0 +1,176 @@
+#ifndef _ML_FRAME_PIPELINE_HPP_
+#define _ML_FRAME_PIPELINE_HPP_
+
+#include <modus_core/detail/Method.hpp>
+#include <modus_core/graphics/CommandBuffer.hpp>
+#include <modus_core/gui/ImGui.hpp>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace ml
+{
+	// render frame
+	struct ML_CORE_API render_frame final : non_copyable
+	{
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		using allocator_type = typename pmr::polymorphic_allocator<byte>;
+
+		render_frame(allocator_type alloc = {}) noexcept
+			: index				{}
+			, framebuffer_size	{}
+			, commands			{ alloc }
+			, draw_data			{}
+			, m_draw_lists		{ alloc }
+			, m_draw_copy		{}
+			, m_releases		{ alloc }
+		{
+		}
+
+		~render_frame() noexcept { clear(); }
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		uint64				index				; // frame index
+		vec2i				framebuffer_size	; // framebuffer size
+		gfx::command_buffer	commands			; // render commands
+		ImDrawData *		draw_data			; // imgui draw data
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		// release recorded data
+		void clear() noexcept;
+
+		// release recorded commands and deferred objects, leaving the imgui copy,
+		// called by the render thread so gfx objects die while the context is current
+		void release_objects() noexcept;
+
+		// keep an object alive until this frame has been rendered
+		void release(ref<void> value) { if (value) { m_releases.push_back(std::move(value)); } }
+
+		// reference the live imgui draw data
+		void reference_draw_data(ImDrawData * value) noexcept;
+
+		// deep copy imgui draw data so it outlives the next imgui frame
+		void capture_draw_data(ImDrawData const * value);
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	private:
+		list<ImDrawList *>	m_draw_lists	; // owned draw lists
+		ImDrawData			m_draw_copy		; // owned draw data
+		list<ref<void>>		m_releases		; // deferred releases
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+	};
+}
+
+namespace ml
+{
+	// bounded frame queue between the main thread and a render thread which owns the context,
+	// the render thread releases the gfx objects a frame holds and the main thread frees the rest
+	struct ML_CORE_API frame_pipeline final : non_copyable
+	{
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		using render_fn = typename method<void(render_frame &)>;
+
+		using job_fn = typename method<void()>;
+
+		enum : size_t { max_latency = 2 };
+
+		frame_pipeline();
+
+		~frame_pipeline() noexcept;
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		// set the function used to submit a frame
+		void set_render_fn(render_fn const & fn) noexcept { m_render_fn = fn; }
+
+		// set how many frames may be queued ahead of the render thread
+		void set_latency(size_t value) noexcept
+		{
+			if (!is_running()) { m_latency = std::clamp<size_t>(value, 1, max_latency); }
+		}
+
+		// move the context of window onto a render thread
+		bool start(window_handle window);
+
+		// join the render thread and make the context current on the caller
+		void stop();
+
+		// hand the recorded frame to the render stage
+		void submit();
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		// run a job on the thread owning the context and wait for it
+		void dispatch(job_fn const & fn);
+
+		// run fn on the thread owning the context and return its result
+		template <class Fn
+		> auto invoke(Fn && fn) -> std::invoke_result_t<Fn>
+		{
+			using result_type = typename std::invoke_result_t<Fn>;
+
+			if constexpr (std::is_void_v<result_type>)
+			{
+				dispatch([&fn]() { std::invoke(fn); });
+			}
+			else
+			{
+				std::optional<result_type> result{};
+				dispatch([&fn, &result]() { result.emplace(std::invoke(fn)); });
+				return std::move(*result);
+			}
+		}
+
+		// keep an object alive until the frame being built has been rendered
+		template <class T
+		> void release(ref<T> value)
+		{
+			get_build_frame().release(std::static_pointer_cast<void>(std::move(value)));
+		}
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		ML_NODISCARD bool is_running() const noexcept { return m_thread.joinable(); }
+
+		ML_NODISCARD bool is_render_thread() const noexcept { return std::this_thread::get_id() == m_thread.get_id(); }
+
+		ML_NODISCARD auto get_latency() const noexcept -> size_t { return m_latency; }
+
+		ML_NODISCARD auto get_build_frame() noexcept -> render_frame & { return m_frames[m_build_index]; }
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	private:
+		void render_loop();
+
+		void run_jobs(std::unique_lock<std::mutex> & lock);
+
+		pmr::synchronized_pool_resource	m_pool		; // frame and job storage, touched by both threads
+
+		window_handle			m_window					; // window
+		render_fn				m_render_fn					; // render function
+		render_frame			m_frames[max_latency + 1]	; // frame ring
+		size_t					m_latency					; // max queued frames
+		size_t					m_build_index				; // index of frame being recorded
+		size_t					m_render_index				; // index of next frame to render
+		size_t					m_queued					; // frames waiting on render thread
+		list<job_fn>			m_jobs						; // pending jobs
+		uint64					m_jobs_pushed				; // jobs pushed
+		uint64					m_jobs_done					; // jobs completed
+		std::thread				m_thread					; // render thread
+		std::mutex				m_mutex						; // mutex
+		std::condition_variable	m_cv						; // condition
+		bool					m_quit						; // quit flag
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+	};
+}
+
+#endif // !_ML_FRAME_PIPELINE_HPP_
\ No newline at end of file
@@ -12,14 +12,28 @@ namespace ml
 		: core_application	{ argc, argv, argj, alloc }
 		, m_window			{ alloc }
 		, m_render_device	{}
+		, m_program_cache	{}
 		, m_imgui			{}
 		, m_dockspace		{ "##MainDockspace", true, ImGuiDockNodeFlags_AutoHideTabBar }
+		, m_pipeline		{}
+		, m_frame_sync		{}
+		, m_gpu_profiler	{}
 
 		, m_loop_timer		{}
 		, m_delta_time		{}
 		, m_frame_index		{}
 		, m_fps				{ 120, alloc }
 		, m_input			{}
+
+		, m_idle_mode		{}
+		, m_idle_timeout	{ 0.5 }
+		, m_redraw_frames	{ 1 }
+
+		, m_fixed_time_step		{ 1.f / 60.f }
+		, m_fixed_max_steps		{ 5 }
+		, m_fixed_accumulator	{}
+		, m_fixed_index			{}
+		, m_fixed_alpha			{}
 	{
 		ML_ctor_global(gui_application);
 
@@ -28,7 +42,14 @@ namespace ml
 			key_event,
 			mouse_button_event,
 			mouse_pos_event,
-			mouse_wheel_event
+			mouse_wheel_event,
+			window_content_scale_event,
+			window_drop_event,
+			window_focus_event,
+			window_framebuffer_resize_event,
+			window_iconify_event,
+			window_maximize_event,
+			window_refresh_event
 		>();
 
 		// create imgui context
@@ -48,10 +69,18 @@ namespace ml
 	{
 		ML_dtor_global(gui_application);
 
+		m_pipeline.stop();
+
+		m_frame_sync.reset();
+
+		m_gpu_profiler.reset();
+
 		_ML ImGui_Shutdown();
 
 		ImGui::DestroyContext(m_imgui.release());
 
+		m_program_cache.reset();
+
 		gfx::destroy_device(m_render_device.release());
 	}
 
@@ -64,7 +93,13 @@ namespace ml
 		while (m_window.is_open())
 		{
 			m_loop_timer.restart();
-			window_api::poll_events();
+			bool const waited{ m_idle_mode && !is_invalidated() };
+			if (waited) {
+				window_api::wait_events(m_idle_timeout);
+			}
+			else {
+				window_api::poll_events();
+			}
 			on_idle(m_delta_time);
 
 			_ML ImGui_NewFrame();
@@ -74,9 +109,19 @@ namespace ml
 			ImGui::Render();
 
 			on_end_frame();
+			for (uint32 n{ m_redraw_frames }; n && !m_redraw_frames.compare_exchange_weak(n, n - 1);) {}
+			++m_frame_index;
+
+			// waiting is still simulated time, capped like the fixed step accumulator
 			m_delta_time = m_loop_timer.elapsed();
+			if (duration const max_dt{ m_fixed_time_step.count() * (float32)m_fixed_max_steps }
+			; waited && max_dt < m_delta_time) {
+				m_delta_time = max_dt;
+			}
 		}
 
+		m_pipeline.stop();
+
 		on_shutdown();
 
 		return core_application::run();
@@ -91,11 +136,34 @@ namespace ml
 
 	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
+	void gui_application::invalidate(uint32 frames) noexcept
+	{
+		uint32 prev{ m_redraw_frames };
+		while (prev < frames && !m_redraw_frames.compare_exchange_weak(prev, frames)) {}
+
+		// wake the main loop if it is blocked waiting for events
+		if (!prev && m_idle_mode && m_window.is_open()) { window_api::post_empty_event(); }
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
 	void gui_application::on_startup()
 	{
+		// setup simulation
+		if (has_attr("fixed_update")) {
+			json & j_fixed{ get_attr("fixed_update") };
+			if (j_fixed.contains("rate")) { set_fixed_time_step(duration{ 1.f / j_fixed["rate"].get<float32>() }); }
+			if (j_fixed.contains("max_steps")) { j_fixed["max_steps"].get_to(m_fixed_max_steps); }
+		}
+
 		// setup window
 		ML_assert(has_attr("window"));
 		json & j_window{ get_attr("window") };
+		if (j_window.contains("idle")) {
+			json & j_idle{ j_window["idle"] };
+			if (j_idle.contains("enabled")) { j_idle["enabled"].get_to(m_idle_mode); }
+			if (j_idle.contains("timeout")) { j_idle["timeout"].get_to(m_idle_timeout); }
+		}
 		ML_verify(m_window.open
 		(
 			j_window.contains("title") ? j_window["title"] : get_app_name(),
@@ -139,6 +207,11 @@ namespace ml
 			ctx->set_depth_state({});
 			ctx->set_stencil_state({});
 		});
+		m_program_cache = make_scope<program_cache>(get_path_to("cache/programs"));
+		get_render_context()->set_fallback_program(gfx::make_fallback_program());
+		if (j_window.contains("frames_in_flight")) {
+			m_frame_sync.set_frames_in_flight(j_window["frames_in_flight"].get<size_t>());
+		}
 
 		// setup imgui
 		json & j_imgui{ get_attr("imgui") };
@@ -151,6 +224,28 @@ namespace ml
 		}
 
 		get_bus()->broadcast<runtime_startup_event>(this);
+
+		// setup pipeline
+		m_pipeline.set_render_fn([&](render_frame & frame) { on_render_frame(frame); });
+		// "pipelined" is either a flag or the number of frames queued ahead of the render thread
+		size_t latency{};
+		if (j_window.contains("pipelined")) {
+			json & j_pipelined{ j_window["pipelined"] };
+			latency = j_pipelined.is_boolean() ? (size_t)j_pipelined.get<bool>() : j_pipelined.get<size_t>();
+		}
+		if (latency)
+		{
+			m_pipeline.set_latency(latency);
+
+			// platform windows are rendered on the main thread
+			m_imgui->IO.ConfigFlags &= ~ImGuiConfigFlags_ViewportsEnable;
+
+			// imgui creates its device objects lazily in new frame
+			ML_verify(_ML ImGui_CreateDeviceObjects());
+			get_render_context()->invalidate_cache();
+
+			ML_verify(m_pipeline.start(m_window.get_handle()));
+		}
 	}
 
 	void gui_application::on_shutdown()
@@ -165,9 +260,11 @@ namespace ml
 		m_fps.update(dt);
 
 		// handle input
+		bool held{};
 		m_input.mouse_delta = m_input.mouse_pos - m_input.last_mouse_pos;
 		m_input.last_mouse_pos = m_input.mouse_pos;
 		for (size_t i = 0; i < mouse_button_MAX; ++i) {
+			held |= m_input.mouse_down[i];
 			m_input.mouse_down_duration[i] = (m_input.mouse_down[i]
 				? (m_input.mouse_down_duration[i] < 0.f
 					? 0.f
@@ -175,6 +272,7 @@ namespace ml
 				: -1.f);
 		}
 		for (size_t i = 0; i < keycode_MAX; ++i) {
+			held |= m_input.keys_down[i];
 			m_input.keys_down_duration[i] = (m_input.keys_down[i]
 				? (m_input.keys_down_duration[i] < 0.f
 					? 0.f
@@ -182,9 +280,29 @@ namespace ml
 				: -1.f);
 		}
 
+		// keep redrawing while anything is held
+		if (held) { invalidate(); }
+
+		// fixed update
+		float32 const step{ m_fixed_time_step.count() };
+		float32 accum{ m_fixed_accumulator.count() + dt.count() };
+		if (float32 const max_accum{ step * (float32)m_fixed_max_steps }; max_accum < accum) {
+			accum = max_accum; // drop time rather than spiral
+		}
+		for (; step <= accum; accum -= step, ++m_fixed_index) {
+			on_fixed_update(m_fixed_time_step);
+		}
+		m_fixed_accumulator = duration{ accum };
+		m_fixed_alpha = accum / step;
+
 		get_bus()->broadcast<runtime_idle_event>(this);
 	}
 
+	void gui_application::on_fixed_update(duration dt)
+	{
+		get_bus()->broadcast<runtime_fixed_update_event>(this, dt);
+	}
+
 	void gui_application::on_gui()
 	{
 		bool const main_menu_bar{ (bool)ImGui::FindWindowByName("##MainMenuBar") };
@@ -202,40 +320,107 @@ namespace ml
 
 	void gui_application::on_end_frame()
 	{
+		// hand off frame
+		render_frame & frame{ m_pipeline.get_build_frame() };
+		frame.index = m_frame_index;
+		frame.framebuffer_size = m_window.get_framebuffer_size();
+		if (m_pipeline.is_running()) {
+			frame.capture_draw_data(&m_imgui->Viewports[0]->DrawDataP);
+		}
+		else {
+			frame.reference_draw_data(&m_imgui->Viewports[0]->DrawDataP);
+		}
+		m_pipeline.submit();
+
+		// update gui windows
+		if (!m_pipeline.is_running() && (m_imgui->IO.ConfigFlags & ImGuiConfigFlags_DockingEnable)) {
+			window_handle const backup{ window_api::get_active_window() };
+			ImGui::UpdatePlatformWindows();
+			ImGui::RenderPlatformWindowsDefault();
+			window_api::set_active_window(backup);
+			get_render_context()->invalidate_cache();
+		}
+
+		// reset inputs
+		m_input.mouse_wheel = 0.f;
+
+		// end frame event
+		get_bus()->broadcast<runtime_end_frame_event>(this);
+	}
+
+	void gui_application::on_render_frame(render_frame & frame)
+	{
+		// wait for the gpu to fall within the frames in flight limit
+		m_frame_sync.begin_frame(get_render_context().get());
+
+		// gpu timings, read back a few frames late
+		m_gpu_profiler.begin_frame(get_render_context().get(), frame.index);
+
 		// clear screen
 		get_render_context()->execute([&](gfx::render_context * ctx) noexcept
 		{
-			ctx->set_viewport({ { 0, 0 }, (vec2)m_window.get_framebuffer_size() });
+			ctx->set_viewport({ { 0, 0 }, (vec2)frame.framebuffer_size });
 			ctx->set_clear_color(colors::black);
 			ctx->clear(gfx::clear_flags_color);
 		});
 
+		// render commands
+		{
+			ML_gpu_scope(&m_gpu_profiler, get_render_context().get(), "commands");
+
+			get_render_context()->submit(frame.commands);
+		}
+
 		// render gui
-		_ML ImGui_RenderDrawData(&m_imgui->Viewports[0]->DrawDataP);
+		if (frame.draw_data) {
+			ML_gpu_scope(&m_gpu_profiler, get_render_context().get(), "imgui");
 
-		// update gui windows
-		if (m_imgui->IO.ConfigFlags & ImGuiConfigFlags_DockingEnable) {
-			window_handle const backup{ window_api::get_active_window() };
-			ImGui::UpdatePlatformWindows();
-			ImGui::RenderPlatformWindowsDefault();
-			window_api::set_active_window(backup);
+			_ML ImGui_RenderDrawData(frame.draw_data);
+
+			// the imgui backend talks to gl directly
+			get_render_context()->invalidate_cache();
 		}
 
+		m_gpu_profiler.end_frame(get_render_context().get());
+
 		// swap buffers
 		if (m_window.has_hints(window_hints_doublebuffer)) {
 			window_api::swap_buffers(m_window.get_handle());
 		}
 
-		// reset inputs
-		m_input.mouse_wheel = 0.f;
+		m_frame_sync.end_frame(get_render_context().get());
 
-		// end frame event
-		get_bus()->broadcast<runtime_end_frame_event>(this);
+		// publish this frame's counters
+		m_render_device->flush_stats();
+
+		// programs finished compiling replace their fallback from the next frame
+		m_render_device->poll_programs();
+
+		// and their binaries go to the cache
+		if (m_program_cache) { m_program_cache->flush(); }
 	}
 
 	void gui_application::on_event(event const & value)
 	{
 		core_application::on_event(value);
+		switch (value)
+		{
+		case char_event::ID:
+		case key_event::ID:
+		case mouse_button_event::ID:
+		case mouse_pos_event::ID:
+		case mouse_wheel_event::ID:
+		case window_content_scale_event::ID:
+		case window_drop_event::ID:
+		case window_focus_event::ID:
+		case window_framebuffer_resize_event::ID:
+		case window_iconify_event::ID:
+		case window_maximize_event::ID:
+		case window_refresh_event::ID: {
+			invalidate(3); // imgui needs a few frames to settle after input
+		} break;
+		}
+
 		switch (value)
 		{
 		case char_event::ID: {
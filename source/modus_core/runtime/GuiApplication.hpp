@@ -2,11 +2,17 @@
 #define _ML_GUI_APPLICATION_HPP_
 
 #include <modus_core/runtime/CoreApplication.hpp>
+#include <modus_core/runtime/FramePipeline.hpp>
+#include <modus_core/graphics/FrameSync.hpp>
+#include <modus_core/graphics/GpuProfiler.hpp>
+#include <modus_core/graphics/ProgramCache.hpp>
 #include <modus_core/graphics/RenderTarget.hpp>
 #include <modus_core/gui/Dockspace.hpp>
 #include <modus_core/gui/PanelWindow.hpp>
 #include <modus_core/window/NativeWindow.hpp>
 
+#include <atomic>
+
 namespace ml
 {
 	// fps tracker
@@ -87,11 +93,80 @@ namespace ml
 
 		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
+	public:
+		// request that the next N frames be redrawn, safe to call from any thread
+		void invalidate(uint32 frames = 1) noexcept;
+
+		ML_NODISCARD bool is_invalidated() const noexcept { return 0 < m_redraw_frames; }
+
+		ML_NODISCARD bool is_idle_mode() const noexcept { return m_idle_mode; }
+
+		ML_NODISCARD auto get_idle_timeout() const noexcept -> float64 { return m_idle_timeout; }
+
+		void set_idle_mode(bool value) noexcept
+		{
+			if (m_idle_mode != value) { m_idle_mode = value; invalidate(); }
+		}
+
+		void set_idle_timeout(float64 value) noexcept { m_idle_timeout = value; }
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	public:
+		// fixed simulation step
+		ML_NODISCARD auto get_fixed_time_step() const noexcept -> duration { return m_fixed_time_step; }
+
+		// max simulation steps per frame
+		ML_NODISCARD auto get_fixed_max_steps() const noexcept -> uint32 { return m_fixed_max_steps; }
+
+		// simulation steps taken since startup
+		ML_NODISCARD auto get_fixed_frame() const noexcept -> uint64 { return m_fixed_index; }
+
+		// blend factor between the previous and current simulation states
+		ML_NODISCARD auto get_fixed_alpha() const noexcept -> float32 { return m_fixed_alpha; }
+
+		void set_fixed_time_step(duration value) noexcept { if (0.f < value.count()) { m_fixed_time_step = value; } }
+
+		void set_fixed_max_steps(uint32 value) noexcept { m_fixed_max_steps = value; }
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	public:
+		// record render commands into the frame being built
+		// while pipelined, the render context is owned by the render thread,
+		// so all rendering after startup must go through here
+		template <class ... Args
+		> void submit(Args && ... args)
+		{
+			auto & cmds{ get_commands() };
+
+			(cmds.push(ML_forward(args)), ...);
+		}
+
+		// packet buffer of the frame being built, records without allocating
+		ML_NODISCARD auto get_commands() noexcept -> gfx::command_buffer & { return m_pipeline.get_build_frame().commands; }
+
+		ML_NODISCARD bool is_pipelined() const noexcept { return m_pipeline.is_running(); }
+
+		// create or update resources from the main thread while pipelined
+		template <class Fn
+		> auto invoke(Fn && fn) { return m_pipeline.invoke(ML_forward(fn)); }
+
+		// drop a resource once the frame being built has been rendered
+		template <class T
+		> void release(ref<T> value) { m_pipeline.release(std::move(value)); }
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
 	public:
 		ML_NODISCARD auto get_delta_time() const noexcept -> duration { return m_delta_time; }
 
 		ML_NODISCARD auto get_fps() const noexcept { return const_cast<fps_tracker *>(&m_fps); }
 
+		ML_NODISCARD auto get_frame_sync() const noexcept { return const_cast<frame_sync *>(&m_frame_sync); }
+
+		ML_NODISCARD auto get_gpu_profiler() const noexcept { return const_cast<gpu_profiler *>(&m_gpu_profiler); }
+
 		ML_NODISCARD auto get_frame() const noexcept -> uint64 { return m_frame_index; }
 
 		ML_NODISCARD auto get_input() const noexcept { return const_cast<input_state *>(&m_input); }
@@ -102,6 +177,8 @@ namespace ml
 
 		ML_NODISCARD auto get_render_context() const noexcept -> ref<gfx::render_context> const & { return m_render_device->get_context(); }
 
+		ML_NODISCARD auto get_program_cache() const noexcept -> scope<program_cache> const & { return m_program_cache; }
+
 		ML_NODISCARD auto get_imgui() const noexcept -> scary<ImGuiContext> const & { return m_imgui; }
 
 		ML_NODISCARD auto get_dockspace() const noexcept { return const_cast<ImGuiExt::Dockspace *>(&m_dockspace); }
@@ -115,10 +192,14 @@ namespace ml
 
 		virtual void on_idle(duration dt);
 
+		virtual void on_fixed_update(duration dt);
+
 		virtual void on_gui();
 
 		virtual void on_end_frame();
 
+		virtual void on_render_frame(render_frame & frame);
+
 		virtual void on_event(event const & value) override;
 
 		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
@@ -126,14 +207,28 @@ namespace ml
 	private:
 		native_window				m_window		; // main window
 		scary<gfx::render_device>	m_render_device	; // render device
+		scope<program_cache>		m_program_cache	; // program binaries
 		scary<ImGuiContext>			m_imgui			; // imgui context
 		ImGuiExt::Dockspace			m_dockspace		; // dockspace
+		frame_pipeline				m_pipeline		; // frame pipeline
+		frame_sync					m_frame_sync	; // frames in flight
+		gpu_profiler				m_gpu_profiler	; // gpu timings
 		
 		timer			m_loop_timer	; // loop timer
 		duration		m_delta_time	; // delta time
 		uint64			m_frame_index	; // frame index
 		fps_tracker		m_fps			; // fps tracker
 		input_state		m_input			; // input state
+
+		bool			m_idle_mode		; // wait for events instead of polling
+		float64			m_idle_timeout	; // max seconds between idle frames
+		std::atomic<uint32>	m_redraw_frames	; // frames left to redraw
+
+		duration		m_fixed_time_step	; // fixed time step
+		uint32			m_fixed_max_steps	; // max steps per frame
+		duration		m_fixed_accumulator	; // unsimulated time
+		uint64			m_fixed_index		; // fixed step index
+		float32			m_fixed_alpha		; // interpolation alpha
 		
 		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 	};
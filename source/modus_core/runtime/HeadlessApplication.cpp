@@ -0,0 +1,200 @@
+#include <modus_core/runtime/HeadlessApplication.hpp>
+#include <modus_core/graphics/Shader.hpp>
+
+namespace ml
+{
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	headless_application::headless_application(int32 argc, char * argv[], json const & argj, allocator_type alloc)
+		: core_application	{ argc, argv, argj, alloc }
+		, m_context			{ alloc }
+		, m_render_device	{}
+		, m_framebuffer		{}
+		, m_commands		{ alloc }
+		, m_frame_sync		{}
+		, m_gpu_profiler	{}
+
+		, m_loop_timer		{}
+		, m_delta_time		{}
+		, m_frame_index		{}
+		, m_frame_count		{}
+		, m_running			{}
+	{
+		ML_ctor_global(headless_application);
+	}
+
+	headless_application::~headless_application() noexcept
+	{
+		ML_dtor_global(headless_application);
+
+		m_commands.clear();
+
+		m_frame_sync.reset();
+
+		m_gpu_profiler.reset();
+
+		m_framebuffer.reset();
+
+		gfx::destroy_device(m_render_device.release());
+
+		m_context.close();
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	int32 headless_application::run()
+	{
+		on_startup();
+
+		m_running = true;
+
+		while (m_running && (!m_frame_count || m_frame_index < m_frame_count))
+		{
+			m_loop_timer.restart();
+
+			on_update(m_delta_time);
+
+			render_frame();
+
+			m_delta_time = m_loop_timer.elapsed();
+		}
+
+		on_shutdown();
+
+		return core_application::run();
+	}
+
+	void headless_application::exit(int32 exit_code)
+	{
+		m_running = false;
+
+		return core_application::exit(exit_code);
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	void headless_application::render_frame()
+	{
+		on_render_frame();
+
+		m_commands.clear();
+
+		++m_frame_index;
+	}
+
+	bitmap headless_application::capture() const
+	{
+		if (!m_framebuffer) { return bitmap{}; }
+
+		ref<gfx::texture2d> const & value{ m_framebuffer->get_color_attachments().front() };
+
+		value->lock();
+
+		bitmap temp{ value->copy_to_image() };
+
+		value->unlock();
+
+		return temp;
+	}
+
+	void headless_application::resize(vec2i const & value)
+	{
+		if (m_framebuffer) { m_framebuffer->resize(value); }
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	void headless_application::on_startup()
+	{
+		// setup context
+		vec2i size{ 1280, 720 };
+		headless_backend_ backend{ headless_backend_any };
+		context_settings cs{};
+		gfx::spec<gfx::render_context> rs{};
+		if (has_attr("headless")) {
+			json & j_headless{ get_attr("headless") };
+			if (j_headless.contains("size")) { j_headless["size"].get_to(size); }
+			if (j_headless.contains("backend")) { j_headless["backend"].get_to(backend); }
+			if (j_headless.contains("context")) {
+				j_headless["context"].get_to(cs);
+				j_headless["context"].get_to(rs);
+			}
+			if (j_headless.contains("frames")) { j_headless["frames"].get_to(m_frame_count); }
+			if (j_headless.contains("frames_in_flight")) {
+				m_frame_sync.set_frames_in_flight(j_headless["frames_in_flight"].get<size_t>());
+			}
+		}
+		ML_verify(m_context.open(size, cs, backend));
+
+		// setup graphics
+		m_render_device.reset(gfx::render_device::create({ rs.api }));
+		m_render_device->set_context(m_render_device->new_context(rs));
+		m_render_device->get_context()->execute([](gfx::render_context * ctx) noexcept
+		{
+			ctx->set_alpha_state({});
+			ctx->set_blend_state({});
+			ctx->set_cull_state({});
+			ctx->set_depth_state({});
+			ctx->set_stencil_state({});
+		});
+		get_render_context()->set_fallback_program(gfx::make_fallback_program());
+
+		// there may be no default framebuffer, everything renders offscreen
+		m_framebuffer = gfx::framebuffer::create(gfx::spec<gfx::framebuffer>{ size });
+	}
+
+	void headless_application::on_shutdown()
+	{
+	}
+
+	void headless_application::on_update(duration dt)
+	{
+	}
+
+	void headless_application::on_render_frame()
+	{
+		// wait for the gpu to fall within the frames in flight limit
+		m_frame_sync.begin_frame(get_render_context().get());
+
+		// gpu timings, read back a few frames late
+		m_gpu_profiler.begin_frame(get_render_context().get(), m_frame_index);
+
+		// clear target
+		get_render_context()->execute([&](gfx::render_context * ctx) noexcept
+		{
+			ctx->bind_framebuffer(m_framebuffer.get());
+			ctx->set_viewport({ { 0, 0 }, (vec2)m_framebuffer->get_size() });
+			ctx->set_clear_color(colors::black);
+			ctx->clear(gfx::clear_flags_all);
+		});
+
+		// render commands
+		{
+			ML_gpu_scope(&m_gpu_profiler, get_render_context().get(), "commands");
+
+			get_render_context()->submit(m_commands);
+		}
+
+		m_gpu_profiler.end_frame(get_render_context().get());
+
+		m_frame_sync.end_frame(get_render_context().get());
+
+		// publish this frame's counters
+		m_render_device->flush_stats();
+
+		// programs finished compiling replace their fallback from the next frame
+		m_render_device->poll_programs();
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+}
+
+// global headless_application
+namespace ml::globals
+{
+	static headless_application * g_headless_application{};
+
+	ML_impl_global(headless_application) get_global() { return g_headless_application; }
+
+	ML_impl_global(headless_application) set_global(headless_application * value) { return g_headless_application = value; }
+}
\ No newline at end of file
@@ -0,0 +1,117 @@
+#ifndef _ML_HEADLESS_APPLICATION_HPP_
+#define _ML_HEADLESS_APPLICATION_HPP_
+
+#include <modus_core/runtime/CoreApplication.hpp>
+#include <modus_core/graphics/CommandBuffer.hpp>
+#include <modus_core/graphics/FrameSync.hpp>
+#include <modus_core/graphics/GpuProfiler.hpp>
+#include <modus_core/window/HeadlessContext.hpp>
+
+namespace ml
+{
+	// headless application
+	// renders into an offscreen framebuffer with no window or display,
+	// for benchmarks, golden image tests, and batch rendering on build machines
+	struct ML_CORE_API headless_application : core_application
+	{
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	public:
+		using core_application::allocator_type;
+
+		headless_application(int32 argc, char * argv[], json const & argj = {}, allocator_type alloc = {});
+
+		virtual ~headless_application() noexcept override;
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	public:
+		// renders until exit, or for the number of frames in "headless.frames"
+		virtual int32 run() override;
+
+		virtual void exit(int32 exit_code = EXIT_SUCCESS) override;
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	public:
+		// record render commands into the next frame
+		template <class ... Args
+		> void submit(Args && ... args)
+		{
+			(m_commands.push(ML_forward(args)), ...);
+		}
+
+		// render one frame now, outside of run
+		void render_frame();
+
+		// read back the offscreen color attachment
+		ML_NODISCARD bitmap capture() const;
+
+		void resize(vec2i const & value);
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	public:
+		ML_NODISCARD auto get_commands() noexcept -> gfx::command_buffer & { return m_commands; }
+
+		ML_NODISCARD auto get_context() const noexcept { return const_cast<headless_context *>(&m_context); }
+
+		ML_NODISCARD auto get_delta_time() const noexcept -> duration { return m_delta_time; }
+
+		ML_NODISCARD auto get_frame() const noexcept -> uint64 { return m_frame_index; }
+
+		ML_NODISCARD auto get_frame_count() const noexcept -> uint64 { return m_frame_count; }
+
+		ML_NODISCARD auto get_frame_sync() const noexcept { return const_cast<frame_sync *>(&m_frame_sync); }
+
+		ML_NODISCARD auto get_framebuffer() const noexcept -> ref<gfx::framebuffer> const & { return m_framebuffer; }
+
+		ML_NODISCARD auto get_gpu_profiler() const noexcept { return const_cast<gpu_profiler *>(&m_gpu_profiler); }
+
+		ML_NODISCARD auto get_render_device() const noexcept -> scary<gfx::render_device> const & { return m_render_device; }
+
+		ML_NODISCARD auto get_render_context() const noexcept -> ref<gfx::render_context> const & { return m_render_device->get_context(); }
+
+		// zero renders until exit
+		void set_frame_count(uint64 value) noexcept { m_frame_count = value; }
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	protected:
+		virtual void on_startup();
+
+		virtual void on_shutdown();
+
+		virtual void on_update(duration dt);
+
+		virtual void on_render_frame();
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	private:
+		headless_context			m_context		; // offscreen context
+		scary<gfx::render_device>	m_render_device	; // render device
+		ref<gfx::framebuffer>		m_framebuffer	; // offscreen target
+		gfx::command_buffer			m_commands		; // frame commands
+		frame_sync					m_frame_sync	; // frames in flight
+		gpu_profiler				m_gpu_profiler	; // gpu timings
+
+		timer			m_loop_timer	; // loop timer
+		duration		m_delta_time	; // delta time
+		uint64			m_frame_index	; // frame index
+		uint64			m_frame_count	; // frames to render
+		bool			m_running		; // running
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+	};
+}
+
+// global headless_application
+namespace ml::globals
+{
+	ML_decl_global(headless_application) get_global();
+
+	ML_decl_global(headless_application) set_global(headless_application *);
+}
+
+#endif // !_ML_HEADLESS_APPLICATION_HPP_
\ No newline at end of file
@@ -21,6 +21,11 @@ namespace ml
 		
 		virtual void on_update(duration) = 0;
 
+		virtual void on_fixed_update(duration) {}
+
+		// keep frames coming while the script animates
+		void invalidate() noexcept { if (m_entity.get_tree()) { m_entity.get_tree()->invalidate(); } }
+
 	private:
 		friend scene_tree;
 
@@ -17,6 +17,8 @@ namespace ml
 		{
 			if (!scr.instance)
 			{
+				if (!scr.create_instance) { return; }
+
 				scr.instance = scr.create_instance();
 
 				scr.instance->on_create();
@@ -26,6 +28,18 @@ namespace ml
 		});
 	}
 
+	void scene_tree::on_runtime_fixed_update(duration dt)
+	{
+		if (!m_root) { return; }
+
+		m_reg.view<behavior_component>().each([&](auto e, behavior_component & scr)
+		{
+			if (!scr.instance) { return; }
+
+			scr.instance->on_fixed_update(dt);
+		});
+	}
+
 	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 	template <> void scene_tree::on_component_added<tag_component>(entity & e, tag_component & c)
@@ -27,6 +27,7 @@ namespace ml
 			: m_name{ name.empty() ? "New Scene" : name, alloc }
 			, m_reg	{}
 			, m_root{ _ML make_ref<node>(name, this, nullptr, alloc) }
+			, m_invalidated{}
 		{
 		}
 
@@ -34,6 +35,7 @@ namespace ml
 			: m_name{ alloc }
 			, m_reg	{}
 			, m_root{}
+			, m_invalidated{}
 		{
 			this->swap(std::move(other));
 		}
@@ -51,6 +53,7 @@ namespace ml
 				std::swap(m_name, other.m_name);
 				std::swap(m_reg, other.m_reg);
 				std::swap(m_root, other.m_root);
+				std::swap(m_invalidated, other.m_invalidated);
 			}
 		}
 
@@ -69,11 +72,19 @@ namespace ml
 
 		void set_name(string const & name) noexcept { if (m_name != name) { m_name = name; } }
 
+		// request another frame, for scenes and scripts that animate without input
+		void invalidate() noexcept { m_invalidated = true; }
+
+		// true once per request, the owner passes it on to its application
+		ML_NODISCARD bool consume_invalidated() noexcept { return std::exchange(m_invalidated, false); }
+
 		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 	public:
 		void on_runtime_update(duration dt);
 
+		void on_runtime_fixed_update(duration dt);
+
 		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 	protected:
@@ -88,6 +99,7 @@ namespace ml
 		string			m_name	; // name
 		entt::registry	m_reg	; // registry
 		ref<node>		m_root	; // root node
+		bool			m_invalidated; // wants another frame
 
 		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 	};
@@ -0,0 +1,231 @@
+#include <modus_core/system/JobSystem.hpp>
+
+namespace ml
+{
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	// worker identity of the calling thread
+	static thread_local job_system const *	t_job_system{};
+	static thread_local int32				t_job_worker{ job_system::any_worker };
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	job_system::job_system(size_t worker_count)
+		: m_pool		{ pmr::new_delete_resource() }
+		, m_queues		{}
+		, m_threads		{}
+		, m_pending		{}
+		, m_next		{}
+		, m_quit		{}
+		, m_sleep_mutex	{}
+		, m_sleep_cv	{}
+	{
+		ML_ctor_global(job_system);
+
+		if (!worker_count)
+		{
+			size_t const cores{ (size_t)std::thread::hardware_concurrency() };
+			worker_count = (1 < cores) ? (cores - 1) : 1;
+		}
+
+		// queue zero belongs to the owning thread
+		m_queues.reserve(worker_count + 1);
+		for (size_t i = 0; i < worker_count + 1; ++i)
+		{
+			m_queues.push_back(make_scope<job_queue>(&m_pool));
+		}
+
+		t_job_system = this;
+		t_job_worker = 0;
+
+		m_threads.reserve(worker_count);
+		for (size_t i = 1; i < worker_count + 1; ++i)
+		{
+			m_threads.emplace_back(&job_system::worker_main, this, i);
+		}
+	}
+
+	job_system::~job_system() noexcept
+	{
+		ML_dtor_global(job_system);
+
+		{
+			std::unique_lock<std::mutex> lock{ m_sleep_mutex };
+			m_quit = true;
+		}
+		m_sleep_cv.notify_all();
+
+		for (std::thread & e : m_threads) { e.join(); }
+
+		// drain anything left behind
+		for (job value; next_job(0, value);) { execute(value); }
+
+		if (t_job_system == this) { t_job_system = nullptr; t_job_worker = any_worker; }
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	auto job_system::get_worker_index() const noexcept -> int32
+	{
+		return (t_job_system == this) ? t_job_worker : any_worker;
+	}
+
+	auto job_system::schedule(job_fn const & fn, job_handle counter, int32 affinity) -> job_handle
+	{
+		if (!counter) { counter = make_handle(); }
+		if (!fn) { return counter; }
+
+		counter->value.fetch_add(1, std::memory_order_relaxed);
+
+		// affinity, then the calling worker's own queue, then round robin
+		size_t const count{ m_queues.size() };
+		size_t index;
+		if (0 <= affinity) { index = (size_t)affinity % count; }
+		else if (int32 const self{ get_worker_index() }; 0 <= self) { index = (size_t)self; }
+		else { index = m_next.fetch_add(1, std::memory_order_relaxed) % count; }
+		// counted before it becomes visible so a thief can't take it first
+		m_pending.fetch_add(1, std::memory_order_release);
+		{
+			job_queue & q{ *m_queues[index] };
+			std::unique_lock<std::mutex> lock{ q.mutex };
+			q.jobs.push_back({ fn, counter });
+		}
+
+		// synchronize with sleepers so the wakeup can't be missed
+		{ std::unique_lock<std::mutex> lock{ m_sleep_mutex }; }
+		m_sleep_cv.notify_one();
+
+		return counter;
+	}
+
+	void job_system::wait(job_handle const & counter)
+	{
+		if (!counter) { return; }
+
+		while (!counter->done())
+		{
+			if (run_one()) { continue; }
+
+			// the remaining jobs are running elsewhere, sleep until they finish or more work arrives
+			std::unique_lock<std::mutex> lock{ m_sleep_mutex };
+			m_sleep_cv.wait(lock, [&]() noexcept
+			{
+				return counter->done() || 0 < m_pending.load(std::memory_order_acquire);
+			});
+		}
+
+		std::exception_ptr error{};
+		{
+			std::unique_lock<std::mutex> lock{ counter->mutex };
+			std::swap(error, counter->error);
+		}
+		if (error) { std::rethrow_exception(error); }
+	}
+
+	bool job_system::run_one()
+	{
+		if (job value; next_job(get_worker_index(), value))
+		{
+			execute(value);
+			return true;
+		}
+		return false;
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	bool job_system::pop_job(size_t index, job & value)
+	{
+		job_queue & q{ *m_queues[index] };
+		std::unique_lock<std::mutex> lock{ q.mutex };
+		if (q.jobs.empty()) { return false; }
+		value = std::move(q.jobs.back()); // owner takes newest
+		q.jobs.pop_back();
+		return true;
+	}
+
+	bool job_system::steal_job(size_t thief, job & value)
+	{
+		size_t const count{ m_queues.size() };
+		for (size_t i = 1; i < count; ++i)
+		{
+			job_queue & q{ *m_queues[(thief + i) % count] };
+			std::unique_lock<std::mutex> lock{ q.mutex, std::try_to_lock };
+			if (!lock || q.jobs.empty()) { continue; }
+			value = std::move(q.jobs.front()); // thieves take oldest
+			q.jobs.pop_front();
+			return true;
+		}
+		return false;
+	}
+
+	bool job_system::next_job(int32 index, job & value)
+	{
+		size_t const self{ (0 <= index) ? (size_t)index : 0 };
+
+		if (pop_job(self, value) || steal_job(self, value))
+		{
+			m_pending.fetch_sub(1, std::memory_order_acq_rel);
+			return true;
+		}
+		return false;
+	}
+
+	void job_system::execute(job & value)
+	{
+		try
+		{
+			value.fn();
+		}
+		catch (...)
+		{
+			std::unique_lock<std::mutex> lock{ value.counter->mutex };
+			if (!value.counter->error) { value.counter->error = std::current_exception(); }
+		}
+
+		// wake anyone waiting on the last job
+		if (value.counter->value.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			{ std::unique_lock<std::mutex> lock{ m_sleep_mutex }; }
+			m_sleep_cv.notify_all();
+		}
+
+		value = {};
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	void job_system::worker_main(size_t index)
+	{
+		t_job_system = this;
+		t_job_worker = (int32)index;
+
+		while (true)
+		{
+			if (job value; next_job((int32)index, value))
+			{
+				execute(value);
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock{ m_sleep_mutex };
+			m_sleep_cv.wait(lock, [&]() noexcept
+			{
+				return m_quit || 0 < m_pending.load(std::memory_order_acquire);
+			});
+			if (m_quit) { break; }
+		}
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+}
+
+// global job_system
+namespace ml::globals
+{
+	static job_system * g_job_system{};
+
+	ML_impl_global(job_system) get_global() { return g_job_system; }
+
+	ML_impl_global(job_system) set_global(job_system * value) { return g_job_system = value; }
+}
\ No newline at end of file
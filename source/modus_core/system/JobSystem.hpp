@@ -0,0 +1,171 @@
+#ifndef _ML_JOB_SYSTEM_HPP_
+#define _ML_JOB_SYSTEM_HPP_
+
+#include <modus_core/detail/Globals.hpp>
+#include <modus_core/detail/Method.hpp>
+#include <modus_core/system/Memory.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+// job counter
+namespace ml
+{
+	// number of unfinished jobs, shared by the jobs it tracks
+	struct ML_NODISCARD job_counter final : non_copyable
+	{
+		std::atomic<int32>	value{}	; // unfinished jobs
+		std::mutex			mutex{}	; // guards error
+		std::exception_ptr	error{}	; // first exception thrown by a job
+
+		ML_NODISCARD bool done() const noexcept { return value.load(std::memory_order_acquire) <= 0; }
+	};
+
+	ML_alias job_handle = typename ref<job_counter>;
+}
+
+// job system
+namespace ml
+{
+	// work stealing job system
+	// a job which throws still completes, the first exception is rethrown by wait
+	struct ML_CORE_API job_system final : non_copyable
+	{
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		using job_fn = typename method<void()>;
+
+		enum : int32 { any_worker = -1 };
+
+		struct job final
+		{
+			job_fn		fn		; // function
+			job_handle	counter	; // counter
+		};
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		// worker_count of zero uses one thread per core, less the calling thread
+		explicit job_system(size_t worker_count = 0);
+
+		~job_system() noexcept;
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		// number of queues, including the owning thread
+		ML_NODISCARD auto get_worker_count() const noexcept -> size_t { return m_queues.size(); }
+
+		// queue index of the calling thread, zero is the owning thread, -1 if external
+		ML_NODISCARD auto get_worker_index() const noexcept -> int32;
+
+		ML_NODISCARD static job_handle make_handle() noexcept { return _ML make_ref<job_counter>(); }
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		// queue a job, affinity is a hint for which worker's queue to use
+		auto schedule(job_fn const & fn, job_handle counter = {}, int32 affinity = any_worker) -> job_handle;
+
+		// run queued jobs on the calling thread until the counter reaches zero,
+		// sleeps while there is nothing to help with
+		void wait(job_handle const & counter);
+
+		// run one queued job on the calling thread
+		bool run_one();
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		// invoke fn(i) for every i in [first, last)
+		template <class Fn
+		> void parallel_for(size_t first, size_t last, Fn && fn, size_t grain = 0)
+		{
+			if (last <= first) { return; }
+			size_t const count{ last - first };
+			if (!grain) { grain = (std::max)((size_t)1, count / (get_worker_count() * 4)); }
+			if (count <= grain) { for (size_t i = first; i < last; ++i) { fn(i); } return; }
+
+			job_handle const counter{ make_handle() };
+			for (size_t i = first + grain; i < last; i += grain)
+			{
+				size_t const end{ (std::min)(i + grain, last) };
+				schedule([&fn, i, end]() { for (size_t j = i; j < end; ++j) { fn(j); } }, counter);
+			}
+
+			// scheduled jobs reference fn, so they must finish before anything unwinds
+			std::exception_ptr error{};
+			try { for (size_t i = first; i < first + grain; ++i) { fn(i); } }
+			catch (...) { error = std::current_exception(); }
+			wait(counter);
+			if (error) { std::rethrow_exception(error); }
+		}
+
+		// map every i in [first, last) and fold the results
+		template <class T, class Map, class Reduce
+		> ML_NODISCARD T parallel_reduce(size_t first, size_t last, T identity, Map && map, Reduce && reduce, size_t grain = 0)
+		{
+			if (last <= first) { return identity; }
+			size_t const count{ last - first };
+			if (!grain) { grain = (std::max)((size_t)1, count / (get_worker_count() * 4)); }
+
+			std::vector<T> partial((count + grain - 1) / grain, identity);
+			parallel_for(0, partial.size(), [&](size_t chunk)
+			{
+				size_t const begin{ first + chunk * grain }, end{ (std::min)(begin + grain, last) };
+				T value{ identity };
+				for (size_t i = begin; i < end; ++i) { value = reduce(std::move(value), map(i)); }
+				partial[chunk] = std::move(value);
+			}, 1);
+
+			T result{ std::move(identity) };
+			for (T & e : partial) { result = reduce(std::move(result), std::move(e)); }
+			return result;
+		}
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	private:
+		struct job_queue final
+		{
+			std::mutex			mutex	; // mutex
+			pmr::deque<job>		jobs	; // jobs
+
+			job_queue(pmr::memory_resource * mres) noexcept : mutex{}, jobs{ mres } {}
+		};
+
+		bool pop_job(size_t index, job & value);
+
+		bool steal_job(size_t thief, job & value);
+
+		bool next_job(int32 index, job & value);
+
+		void execute(job & value);
+
+		void worker_main(size_t index);
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		pmr::synchronized_pool_resource	m_pool		; // job storage
+		list<scope<job_queue>>			m_queues	; // per worker queues
+		list<std::thread>				m_threads	; // worker threads
+		std::atomic<size_t>				m_pending	; // queued jobs
+		std::atomic<size_t>				m_next		; // round robin
+		std::atomic<bool>				m_quit		; // quit flag
+		std::mutex						m_sleep_mutex; // sleep mutex
+		std::condition_variable			m_sleep_cv	; // sleep condition
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+	};
+}
+
+// global job_system
+namespace ml::globals
+{
+	ML_decl_global(job_system) get_global();
+
+	ML_decl_global(job_system) set_global(job_system *);
+}
+
+#endif // !_ML_JOB_SYSTEM_HPP_
\ No newline at end of file
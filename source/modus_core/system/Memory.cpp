@@ -9,6 +9,7 @@ namespace ml
 		, m_alloc	{ m_resource }
 		, m_records	{ m_alloc }
 		, m_counter	{}
+		, m_mutex	{}
 	{
 		ML_ctor_global(memory_manager);
 	}
@@ -4,6 +4,9 @@
 #include <modus_core/detail/BatchVector.hpp>
 #include <modus_core/detail/Globals.hpp>
 
+#include <atomic>
+#include <mutex>
+
 // simplified interface
 #define ML_free(addr)							(ML_get_global(_ML memory_manager)->deallocate(addr))
 #define ML_malloc(size)							(ML_get_global(_ML memory_manager)->allocate(size))
@@ -16,7 +19,7 @@
 // passthrough resource
 namespace ml
 {
-	// proxy for testing an upstream memory resource
+	// proxy for testing an upstream memory resource, thread safe if the upstream is
 	struct passthrough_resource final : public pmr::memory_resource, non_copyable
 	{
 		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
@@ -47,7 +50,7 @@ namespace ml
 
 		ML_NODISCARD auto get_resource() const noexcept -> pmr::memory_resource * const { return m_resource; }
 
-		ML_NODISCARD auto num_allocations() const noexcept -> size_t { return m_num_allocations; }
+		ML_NODISCARD auto num_allocations() const noexcept -> size_t { return m_num_allocations.load(std::memory_order_relaxed); }
 
 		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
@@ -57,9 +60,9 @@ namespace ml
 
 		ML_NODISCARD auto buffer_size() const noexcept -> size_t { return m_buffer_size; }
 
-		ML_NODISCARD auto buffer_used() const noexcept -> size_t { return m_buffer_used; }
+		ML_NODISCARD auto buffer_used() const noexcept -> size_t { return m_buffer_used.load(std::memory_order_relaxed); }
 
-		ML_NODISCARD auto buffer_free() const noexcept -> size_t { return m_buffer_size - m_buffer_used; }
+		ML_NODISCARD auto buffer_free() const noexcept -> size_t { return m_buffer_size - buffer_used(); }
 
 		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
@@ -102,15 +105,15 @@ namespace ml
 	private:
 		void * do_allocate(size_t bytes, size_t align) override
 		{
-			++m_num_allocations;
-			m_buffer_used += bytes;
+			m_num_allocations.fetch_add(1, std::memory_order_relaxed);
+			m_buffer_used.fetch_add(bytes, std::memory_order_relaxed);
 			return m_resource->allocate(bytes, align);
 		}
 
 		void do_deallocate(void * ptr, size_t bytes, size_t align) override
 		{
-			--m_num_allocations;
-			m_buffer_used -= bytes;
+			m_num_allocations.fetch_sub(1, std::memory_order_relaxed);
+			m_buffer_used.fetch_sub(bytes, std::memory_order_relaxed);
 			return m_resource->deallocate(ptr, bytes, align);
 		}
 
@@ -126,8 +129,8 @@ namespace ml
 		pointer const m_buffer_data;
 		size_t const m_buffer_size;
 
-		size_t m_num_allocations{};
-		size_t m_buffer_used{};
+		std::atomic<size_t> m_num_allocations{};
+		std::atomic<size_t> m_buffer_used{};
 
 		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 	};
@@ -251,7 +254,7 @@ namespace ml
 // memory manager
 namespace ml
 {
-	// memory manager
+	// memory manager, allocation is serialized so it may be used from any thread
 	struct ML_CORE_API memory_manager final : non_copyable
 	{
 		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
@@ -414,6 +417,7 @@ namespace ml
 	private:
 		void * do_allocate(size_t count, size_t size) noexcept
 		{
+			std::unique_lock<std::mutex> lock{ m_mutex };
 			return std::get<ID_addr>(m_records.push_back
 			(
 				++m_counter, count, size, m_alloc.allocate(count * size))
@@ -422,6 +426,7 @@ namespace ml
 
 		void do_deallocate(void * addr) noexcept
 		{
+			std::unique_lock<std::mutex> lock{ m_mutex };
 			if (size_t const i{ m_records.lookup<ID_addr>(addr) }; i != m_records.npos)
 			{
 				m_alloc.deallocate(
@@ -440,6 +445,7 @@ namespace ml
 		allocator_type					m_alloc		; // allocator
 		record_storage					m_records	; // records
 		size_t							m_counter	; // counter
+		std::mutex						m_mutex		; // mutex
 
 		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 	};
@@ -0,0 +1,94 @@
+#include <modus_core/window/HeadlessContext.hpp>
+
+#ifdef ML_IMPL_HEADLESS_EGL
+#include <modus_core/backends/egl/EGL_Context.hpp>
+#endif
+
+#ifdef ML_IMPL_HEADLESS_OSMESA
+#include <modus_core/backends/osmesa/OSMesa_Context.hpp>
+#endif
+
+namespace ml
+{
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	headless_context::headless_context(allocator_type alloc) noexcept
+		: m_alloc	{ alloc }
+		, m_impl	{}
+	{
+	}
+
+	headless_context::~headless_context() noexcept
+	{
+		close();
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	bool headless_context::open(vec2i const & size, context_settings const & cs, int32 backend)
+	{
+		// check already open
+		if (is_open()) { return debug::fail("headless context is already open"); }
+
+		// check api
+		if (cs.api != context_api_opengl) { return debug::fail("headless contexts only support opengl"); }
+
+		// first backend that opens wins
+		auto const wants = [&](int32 value) noexcept
+		{
+			return !m_impl && (backend == headless_backend_any || backend == value);
+		};
+
+		auto const try_open = [&](base_headless_context * impl)
+		{
+			m_impl.reset(impl);
+
+			if (!m_impl->open(size, cs)) { ML_delete(m_impl.release()); }
+		};
+
+#ifdef ML_IMPL_HEADLESS_EGL
+		if (wants(headless_backend_egl)) { try_open(ML_new(egl_context, m_alloc)); }
+#endif
+
+#ifdef ML_IMPL_HEADLESS_OSMESA
+		if (wants(headless_backend_osmesa)) { try_open(ML_new(osmesa_context, m_alloc)); }
+#endif
+
+		if (!m_impl) { return debug::fail("failed opening headless context"); }
+
+		return true;
+	}
+
+	void headless_context::close()
+	{
+		if (!m_impl) { return; }
+
+		m_impl->close();
+
+		ML_delete(m_impl.release());
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	bool headless_context::is_available(int32 backend) noexcept
+	{
+		switch (backend)
+		{
+#ifdef ML_IMPL_HEADLESS_EGL
+		case headless_backend_egl	: return true;
+#endif
+#ifdef ML_IMPL_HEADLESS_OSMESA
+		case headless_backend_osmesa: return true;
+#endif
+		case headless_backend_any	:
+#if defined(ML_IMPL_HEADLESS_EGL) || defined(ML_IMPL_HEADLESS_OSMESA)
+			return true;
+#else
+			return false;
+#endif
+		default: return false;
+		}
+	}
+
+	/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+}
\ No newline at end of file
@@ -0,0 +1,135 @@
+#ifndef _ML_HEADLESS_CONTEXT_HPP_
+#define _ML_HEADLESS_CONTEXT_HPP_
+
+#include <modus_core/window/WindowAPI.hpp>
+
+// HEADLESS BACKEND
+namespace ml
+{
+	// headless backend
+	enum headless_backend_ : int32
+	{
+		headless_backend_any	, // first that opens
+		headless_backend_egl	, // egl surfaceless, device, or pbuffer
+		headless_backend_osmesa	, // osmesa software rasterizer
+	};
+
+	inline void from_json(json const & j, headless_backend_ & v)
+	{
+		if (j.is_number()) { v = (headless_backend_)j.get<int32>(); }
+		else if (j.is_string())
+		{
+			switch (auto const s{ j.get<string>() }; hashof(util::to_lower(s)))
+			{
+			case hashof("any"	): v = headless_backend_any		; break;
+			case hashof("egl"	): v = headless_backend_egl		; break;
+			case hashof("osmesa"): v = headless_backend_osmesa	; break;
+			}
+		}
+	}
+
+	inline void to_json(json & j, headless_backend_ const & v)
+	{
+		switch (v)
+		{
+		case headless_backend_any	: j = "any"		; break;
+		case headless_backend_egl	: j = "egl"		; break;
+		case headless_backend_osmesa: j = "osmesa"	; break;
+		}
+	}
+}
+
+// BACKEND
+namespace ml
+{
+	// backend headless context
+	struct ML_CORE_API base_headless_context : non_copyable, trackable
+	{
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		using allocator_type = typename pmr::polymorphic_allocator<byte>;
+
+		virtual ~base_headless_context() noexcept override = default;
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		ML_NODISCARD virtual bool open(vec2i const & size, context_settings const & cs = {}) = 0;
+
+		virtual void close() = 0;
+
+		virtual bool make_current() = 0;
+
+		virtual void release_current() = 0;
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		ML_NODISCARD virtual int32 get_backend() const = 0;
+
+		ML_NODISCARD virtual void * get_handle() const = 0;
+
+		ML_NODISCARD virtual vec2i get_size() const = 0;
+
+		ML_NODISCARD virtual bool is_current() const = 0;
+
+		ML_NODISCARD virtual bool is_open() const = 0;
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+	};
+}
+
+// HEADLESS CONTEXT
+namespace ml
+{
+	// opengl context with no window or display, renders into framebuffers only
+	struct ML_CORE_API headless_context final : base_headless_context
+	{
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		using base_headless_context::allocator_type;
+
+		headless_context(allocator_type alloc = {}) noexcept;
+
+		~headless_context() noexcept final;
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		ML_NODISCARD bool open(vec2i const & size, context_settings const & cs = {}) final
+		{
+			return open(size, cs, headless_backend_any);
+		}
+
+		// any tries each backend built in, in the order they are declared
+		ML_NODISCARD bool open(vec2i const & size, context_settings const & cs, int32 backend);
+
+		void close() final;
+
+		bool make_current() final { return m_impl && m_impl->make_current(); }
+
+		void release_current() final { if (m_impl) { m_impl->release_current(); } }
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+		ML_NODISCARD int32 get_backend() const final { return m_impl ? m_impl->get_backend() : headless_backend_any; }
+
+		ML_NODISCARD void * get_handle() const final { return m_impl ? m_impl->get_handle() : nullptr; }
+
+		ML_NODISCARD vec2i get_size() const final { return m_impl ? m_impl->get_size() : vec2i{}; }
+
+		ML_NODISCARD bool is_current() const final { return m_impl && m_impl->is_current(); }
+
+		ML_NODISCARD bool is_open() const final { return m_impl && m_impl->is_open(); }
+
+		// whether a backend was built in
+		ML_NODISCARD static bool is_available(int32 backend = headless_backend_any) noexcept;
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+	private:
+		allocator_type					m_alloc	; // allocator
+		scary<base_headless_context>	m_impl	; // backend implementation
+
+		/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+	};
+}
+
+#endif // !_ML_HEADLESS_CONTEXT_HPP_
\ No newline at end of file
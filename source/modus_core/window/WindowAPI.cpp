@@ -41,6 +41,16 @@ namespace ml
 		glfw_platform::poll_events();
 	}
 
+	void window_api::wait_events(float64 timeout)
+	{
+		glfw_platform::wait_events(timeout);
+	}
+
+	void window_api::post_empty_event()
+	{
+		glfw_platform::post_empty_event();
+	}
+
 	void window_api::swap_buffers(window_handle handle)
 	{
 		glfw_platform::swap_buffers(handle);
@@ -146,6 +146,10 @@ namespace ml
 
 		static void poll_events();
 
+		static void wait_events(float64 timeout = -1.0);
+
+		static void post_empty_event();
+
 		static void swap_buffers(window_handle handle);
 
 		static void swap_interval(int32 value);
@@ -18,7 +18,7 @@ static class memcfg final : public singleton<memcfg>
 
 	array<byte, RESERVE_MEMORY>			data{};
 	pmr::monotonic_buffer_resource		mono{ data.data(), data.size() };
-	pmr::unsynchronized_pool_resource	pool{ &mono };
+	pmr::synchronized_pool_resource		pool{ &mono };
 	passthrough_resource				view{ &pool, data.data(), data.size() };
 	memory_manager						mman{ &view };
 